@@ -0,0 +1,77 @@
+#include <iostream>
+#include <vector>
+#include "common/csr_file.h"
+#include "common/csr_graph.h"
+#include "common/edge_list_loader.h"
+using namespace std;
+
+
+int main ()
+{
+
+    // Parse a text edge list once...
+    ofstream MyFile ("edges.txt");
+    MyFile << "0 1 5\n"
+              "0 2 7\n"
+              "1 3 2\n"
+              "2 3 4\n"
+              "3 0 1\n";
+    MyFile.close ();
+
+    EdgeList list = loadEdgeList ("edges.txt");
+    CSRGraph<int> graph = buildGraph (list);
+
+    // the CSR graph keeps the file order within each vertex, so the weight
+    // of every edge goes to the next free slot of its source, as the targets
+    // did: one pass over the edges
+    vector<int32_t> weights (graph.numArcs ());
+    vector<size_t> next (graph.offsets.begin (), graph.offsets.end () - 1);
+    for (LoadedEdge const &edge: list.edges)
+    {
+        weights[next[edge.src]++] = edge.weight;
+    }
+
+
+    // ...save it in the binary CSR format...
+    writeCSRFile<uint32_t> ("graph.csr", graph, &weights);
+
+
+    // ...and map it back as often as needed, with nothing to parse
+    MappedCSRGraph<uint32_t> mapped ("graph.csr");
+    mapped.checkTargets ();    // one pass over the targets, for untrusted files
+
+    cout << mapped.numVertices () << " vertices, " << mapped.numArcs () << " arcs" << endl;
+    for (int v = 0; v < mapped.numVertices (); v++)
+    {
+        cout << v << ":";
+        NeighborRange<uint32_t> targets = mapped.neighbors (v);
+        NeighborRange<int32_t> arcWeights = mapped.weights (v);
+        for (size_t i = 0; i < targets.size (); i++)
+        {
+            cout << " " << targets[i] << " (weight " << arcWeights[i] << ")";
+        }
+        cout << endl;
+    }
+
+
+    // A file written with other vertex ids is rejected
+    try
+    {
+        MappedCSRGraph<uint64_t> wrongWidth ("graph.csr");
+    }
+    catch (runtime_error const &error)
+    {
+        cout << error.what () << endl;
+    }
+
+}
+
+
+// Output:
+
+// 4 vertices, 5 arcs
+// 0: 1 (weight 5) 2 (weight 7)
+// 1: 3 (weight 2)
+// 2: 3 (weight 4)
+// 3: 0 (weight 1)
+// graph.csr: vertex ids are 4 bytes wide, expected 8
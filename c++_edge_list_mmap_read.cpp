@@ -0,0 +1,71 @@
+#include <iostream>
+#include <fstream>
+#include "common/csr_graph.h"
+#include "common/edge_list_loader.h"
+#include "common/thread_pool.h"
+using namespace std;
+
+
+int main ()
+{
+
+    // Create a small edge list file: one "u v" or "u v weight" per line
+    ofstream MyFile ("edges.txt");
+    MyFile << "# a comment line\n"
+              "0 1\n"
+              "0 2 7\n"
+              "1 3\n"
+              "\n"
+              "2 3 4\n";
+    MyFile.close ();
+
+
+    // Map the file into memory and parse it in place, without reading any
+    // line into a string
+    EdgeList list = loadEdgeList ("edges.txt");
+
+    cout << list.edges.size () << " edges, " << list.numVertices << " vertices" << endl;
+    for (LoadedEdge const &edge: list.edges)
+    {
+        cout << edge.src << " -> " << edge.dest << " (weight " << edge.weight << ")" << endl;
+    }
+
+
+    // Or build the graph directly from the file
+    CSRGraph<int> graph = loadGraph ("edges.txt", Undirected);
+
+    for (int v = 0; v < graph.numVertices (); v++)
+    {
+        cout << v << ":";
+        for (int u: graph.neighbors (v))
+        {
+            cout << " " << u;
+        }
+        cout << endl;
+    }
+
+
+    // Large files can be split into chunks and parsed on all cores; the
+    // edges come out in the same order, and the graph can be built on all
+    // cores too
+    ThreadPool pool;
+    EdgeList parallelList = loadEdgeListParallel ("edges.txt", pool, Undirected);
+
+    cout << parallelList.edges.size () << " edges loaded in parallel, "
+         << buildGraph (parallelList, pool).numArcs () << " arcs in the undirected graph" << endl;
+
+}
+
+
+// Output:
+
+// 4 edges, 4 vertices
+// 0 -> 1 (weight 1)
+// 0 -> 2 (weight 7)
+// 1 -> 3 (weight 1)
+// 2 -> 3 (weight 4)
+// 0: 1 2
+// 1: 0 3
+// 2: 0 3
+// 3: 1 2
+// 4 edges loaded in parallel, 8 arcs in the undirected graph
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <fstream>
+#include "common/streaming_islands.h"
+using namespace std;
+
+
+int main ()
+{
+
+    // Create a raster file: one row per line, 1 for land and 0 for water
+    ofstream MyFile ("raster.txt");
+    MyFile << "1010001111\n"
+              "0010101000\n"
+              "1111001000\n"
+              "1001010000\n"
+              "1111000111\n"
+              "0101001111\n"
+              "0000011100\n"
+              "0001001110\n"
+              "1010100100\n"
+              "1111000111\n";
+    MyFile.close ();
+
+
+    // Read it back one line at a time; only the previous row's runs are
+    // kept, so the file could be far larger than memory (or be `cin`,
+    // reading from a pipe). Each island is reported as soon as the row
+    // below it shows it cannot grow any more.
+    ifstream MyReadFile ("raster.txt");
+    size_t islands = countIslandsStreaming (MyReadFile, EightConnected,
+            [] (IslandSummary const &island)
+    {
+        cout << "island of " << island.cells << " cells, rows " << island.top << "-"
+             << island.bottom << ", columns " << island.left << "-" << island.right << endl;
+    });
+    MyReadFile.close ();
+
+    cout << "The total number of islands is " << islands << endl;
+
+
+    // Rows can also be pushed one by one from any other source
+    StreamingIslandCounter counter (4, FourConnected);
+    counter.addRow (vector<int> { 1, 0, 0, 1 });
+    counter.addRow (vector<int> { 0, 1, 1, 0 });
+    counter.finish ();
+
+    cout << counter.count () << " islands without diagonal moves" << endl;
+
+}
+
+
+// Output:
+
+// island of 1 cells, rows 0-0, columns 0-0
+// island of 7 cells, rows 0-3, columns 5-9
+// island of 15 cells, rows 0-5, columns 0-4
+// island of 8 cells, rows 7-9, columns 0-4
+// island of 17 cells, rows 4-9, columns 5-9
+// The total number of islands is 5
+// 3 islands without diagonal moves
@@ -0,0 +1,42 @@
+#ifndef BFS_RESULT_H
+#define BFS_RESULT_H
+
+#include <cstddef>
+#include <vector>
+
+// Output shared by the BFS engines in this directory
+
+// how a single BFS level was expanded
+enum BFSDirection { TopDown, BottomUp };
+
+// statistics of a single BFS level
+struct BFSLevel
+{
+    // distance of the frontier vertices from the source
+    int depth;
+
+    // direction used to expand the frontier
+    BFSDirection direction;
+
+    // number of vertices in the frontier
+    std::size_t frontierSize;
+
+    // number of arcs examined while expanding the frontier
+    std::size_t arcsExamined;
+};
+
+struct BFSResult
+{
+    // `distance[v]` is the number of edges on a shortest path from the
+    // source to `v`, or -1 if `v` is not reachable
+    std::vector<int> distance;
+
+    // `parent[v]` is the predecessor of `v` on a shortest path from the
+    // source; it is -1 for the source and for unreachable vertices
+    std::vector<int> parent;
+
+    // one entry per expanded level, in order of depth
+    std::vector<BFSLevel> levels;
+};
+
+#endif
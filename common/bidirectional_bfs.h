@@ -0,0 +1,182 @@
+#ifndef BIDIRECTIONAL_BFS_H
+#define BIDIRECTIONAL_BFS_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Shortest path between one pair of vertices of an unweighted graph by
+// breadth-first search from both ends.
+//
+// One search grows from the source along the arcs, the other from the
+// target against them (over the reverse graph, which for an undirected
+// graph, a maze or a chessboard is the graph itself). Each round expands a
+// whole level of whichever frontier is smaller, and the search stops at the
+// end of the first level that reaches a vertex already seen from the other
+// end; the shortest path through any of the arcs found in that level is the
+// shortest path overall. With branching factor b and distance d each side
+// only goes about d / 2 levels deep, so the search visits on the order of
+// b^(d/2) vertices instead of b^d.
+//
+// The graph is given by two callables: `forward(v, visit)` calls
+// `visit(w)` for every arc v → w, and `backward(v, visit)` calls `visit(u)`
+// for every arc u → v. Vertices are numbered 0 .. n - 1, with n < 2^31.
+
+struct BidirectionalPath
+{
+    // number of arcs on the path, or -1 if the target cannot be reached
+    int length = -1;
+
+    // the vertices of a shortest path, from the source to the target
+    std::vector<int> path;
+
+    // number of vertices reached by either search
+    std::size_t visited = 0;
+};
+
+// The search state of both sides is allocated once, for `n` vertices, and
+// kept across queries: every entry is tagged with the number of the query
+// that last wrote it, and an entry with an older tag reads as unreached, so
+// a query only costs the vertices it reaches. An entry is 12 bytes and there
+// are two per vertex, so the state of a graph of 2^31 vertices, the most an
+// `int` id can number, already takes 48 GB.
+class BidirectionalBFS
+{
+public:
+    explicit BidirectionalBFS(std::size_t n)
+    {
+        if (n > std::size_t(INT_MAX)) {
+            throw std::length_error("BidirectionalBFS: more vertices than an int can number");
+        }
+        entries[0].resize(n);
+        entries[1].resize(n);
+    }
+
+    template <typename Forward, typename Backward>
+    BidirectionalPath find(int source, int target, Forward const &forward,
+            Backward const &backward)
+    {
+        BidirectionalPath result;
+        if (source == target)
+        {
+            result.length = 0;
+            result.path.push_back(source);
+            result.visited = 1;
+            return result;
+        }
+
+        // after 2^32 queries the tags wrap around, and the old ones must go
+        if (++query == 0)
+        {
+            for (std::vector<Entry> &side: entries)
+            {
+                for (Entry &entry: side) {
+                    entry.query = 0;
+                }
+            }
+            query = 1;
+        }
+
+        // side 0 searches from the source, side 1 from the target
+        reach(0, source, 0, -1);
+        reach(1, target, 0, -1);
+        frontier[0].assign(1, source);
+        frontier[1].assign(1, target);
+        result.visited = 2;
+
+        while (!frontier[0].empty() && !frontier[1].empty())
+        {
+            int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+            int other = 1 - side;
+
+            // shortest path through an arc u – w, u on this side and w seen
+            // from the other one
+            int best = INT_MAX;
+            int meetU = -1, meetW = -1;
+            next.clear();
+
+            for (int u: frontier[side])
+            {
+                int du = dist(side, u);
+                auto visit = [&](int w)
+                {
+                    if (dist(other, w) != -1)
+                    {
+                        int length = du + 1 + dist(other, w);
+                        if (length < best)
+                        {
+                            best = length;
+                            meetU = u;
+                            meetW = w;
+                        }
+                    }
+                    else if (dist(side, w) == -1)
+                    {
+                        reach(side, w, du + 1, u);
+                        next.push_back(w);
+                    }
+                };
+
+                if (side == 0) {
+                    forward(u, visit);
+                }
+                else {
+                    backward(u, visit);
+                }
+            }
+
+            result.visited += next.size();
+            frontier[side].swap(next);
+
+            if (best != INT_MAX)
+            {
+                // `a` is on the source side and `b` on the target side, a → b
+                int a = side == 0 ? meetU : meetW;
+                int b = side == 0 ? meetW : meetU;
+
+                for (int v = a; v != -1; v = entries[0][v].parent) {
+                    result.path.push_back(v);
+                }
+                std::reverse(result.path.begin(), result.path.end());
+                for (int v = b; v != -1; v = entries[1][v].parent) {
+                    result.path.push_back(v);
+                }
+
+                result.length = best;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+private:
+    // `dist` and `parent` are valid if `query` is the current query
+    struct Entry
+    {
+        std::uint32_t query = 0;
+        int dist;
+        int parent;
+    };
+
+    std::vector<Entry> entries[2];
+    std::uint32_t query = 0;
+    std::vector<int> frontier[2], next;
+
+    // distance of `v` from the end searched by `side`, or -1
+    int dist(int side, int v) const
+    {
+        Entry const &entry = entries[side][v];
+        return entry.query == query ? entry.dist : -1;
+    }
+
+    void reach(int side, int v, int d, int parent)
+    {
+        entries[side][v] = { query, d, parent };
+    }
+};
+
+#endif
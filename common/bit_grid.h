@@ -0,0 +1,137 @@
+#ifndef BIT_GRID_H
+#define BIT_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "dense_bitset.h"
+
+// A binary raster (land / water, open / blocked) packed one bit per cell.
+//
+// Every row starts on a fresh 64-bit word, so cell (i, j) is bit `j & 63` of
+// word `j >> 6` of `row(i)`, and whole rows can be processed 64 cells at a
+// time. The bits past the last column of a row are always 0. A 100k × 100k
+// raster takes 1.25 GB this way, against 40 GB as `vector<vector<int>>`.
+
+class BitGrid
+{
+public:
+    // an empty grid with no cells
+    BitGrid() = default;
+
+    // a `rows × cols` grid with every cell 0
+    BitGrid(int rows, int cols)
+        : rowCount(rows), colCount(cols), stride(bitsetWords(cols)),
+          words(std::size_t(rows) * stride, 0) {}
+
+    // pack a `vector<vector<U>>` matrix, as used by the problems; nonzero
+    // cells become 1
+    template <typename U>
+    explicit BitGrid(std::vector<std::vector<U>> const &mat)
+        : BitGrid(mat.size(), mat.empty() ? 0 : mat[0].size())
+    {
+        for (int i = 0; i < rowCount; i++)
+        {
+            for (int j = 0; j < colCount; j++)
+            {
+                if (mat[i][j]) {
+                    set(i, j);
+                }
+            }
+        }
+    }
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+
+    // number of 64-bit words holding each row
+    std::size_t wordsPerRow() const { return stride; }
+
+    std::uint64_t *row(int i) { return words.data() + std::size_t(i) * stride; }
+    std::uint64_t const *row(int i) const { return words.data() + std::size_t(i) * stride; }
+
+    bool test(int i, int j) const { return (row(i)[j >> 6] >> (j & 63)) & 1; }
+
+    void set(int i, int j) { row(i)[j >> 6] |= std::uint64_t(1) << (j & 63); }
+
+    void reset(int i, int j) { row(i)[j >> 6] &= ~(std::uint64_t(1) << (j & 63)); }
+
+    // turn every 0 cell into 1 and every 1 cell into 0, e.g., to pack the
+    // zeros of a matrix; the bits past the last column stay 0
+    void flip()
+    {
+        std::uint64_t last = colCount & 63 ? (std::uint64_t(1) << (colCount & 63)) - 1
+                : ~std::uint64_t(0);
+        for (int i = 0; i < rowCount; i++)
+        {
+            std::uint64_t *r = row(i);
+            for (std::size_t w = 0; w < stride; w++) {
+                r[w] = ~r[w];
+            }
+            if (stride > 0) {
+                r[stride - 1] &= last;
+            }
+        }
+    }
+
+    // number of 1 cells
+    std::size_t count() const
+    {
+        std::size_t total = 0;
+        for (std::uint64_t word: words) {
+            total += __builtin_popcountll(word);
+        }
+        return total;
+    }
+
+private:
+    int rowCount = 0, colCount = 0;
+    std::size_t stride = 0;
+    std::vector<std::uint64_t> words;
+};
+
+// Call `run(begin, end)` for every maximal run of consecutive 1 bits in the
+// packed row `bits` of `cols` cells, from left to right; the run covers
+// columns [begin, end). The row is scanned a word at a time: all-0 words
+// and the inside of long runs cost one comparison per 64 cells.
+template <typename Run>
+void forEachRun(std::uint64_t const *bits, int cols, Run &&run)
+{
+    int words = bitsetWords(cols);
+    int w = 0;
+
+    // `word` holds the bits of word `w` not scanned yet; the loop looks for
+    // the next 1 bit, then for the next 0 bit after it
+    std::uint64_t word = words ? bits[0] : 0;
+
+    while (w < words)
+    {
+        if (word == 0)
+        {
+            if (++w < words) {
+                word = bits[w];
+            }
+            continue;
+        }
+
+        int begin = (w << 6) + __builtin_ctzll(word);
+
+        // complement, and drop the bits below the start of the run
+        word = ~word & (~std::uint64_t(0) << (begin & 63));
+        while (word == 0 && ++w < words) {
+            word = ~bits[w];
+        }
+
+        // the bits past the last column are 0, so a run never ends past
+        // `cols`, and it reaches `cols` exactly when it runs off the last word
+        int end = w < words ? (w << 6) + __builtin_ctzll(word) : cols;
+        run(begin, end);
+
+        // back to the original bits of the word holding `end`, past the run
+        if (w < words) {
+            word = bits[w] & (~std::uint64_t(0) << (end & 63));
+        }
+    }
+}
+
+#endif
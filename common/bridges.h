@@ -0,0 +1,163 @@
+#ifndef BRIDGES_H
+#define BRIDGES_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "dense_bitset.h"
+
+// Bridges, articulation points and 2-edge-connected components of an
+// undirected graph in a single DFS pass (Tarjan's low-link method).
+//
+// `low[v]` is the smallest arrival time reachable from the DFS subtree of
+// `v` with at most one back edge. A tree edge `(u, v)` is a bridge when
+// `low[v] > arrival[u]`, i.e., nothing in the subtree of `v` reaches back
+// to `u` or above, and a non-root `u` is an articulation point when
+// `low[v] >= arrival[u]` for one of its children. The DFS uses an explicit
+// stack of (vertex, next arc) frames, so deep graphs cannot overflow the
+// call stack, and it is restarted from every unvisited vertex so that all
+// connected components are covered. The whole run is O(V + E).
+//
+// Parallel edges are handled: only one copy of the arc back to the parent
+// is skipped, so a second copy counts as a back edge and the pair is not
+// reported as a bridge.
+//
+// `Graph` is an undirected graph (every edge stored in both directions)
+// offering `numVertices()` and `neighbors(v)`, such as `CSRGraph`.
+
+struct BridgeResult
+{
+    // every bridge as (parent, child) in the DFS forest, in the order the
+    // DFS finished the child
+    std::vector<std::pair<int, int>> bridges;
+
+    // articulation points in increasing order
+    std::vector<int> articulationPoints;
+
+    // `component[v]` is the 2-edge-connected component of `v`, i.e., the
+    // connected component of `v` once all bridges are removed
+    std::vector<int> component;
+
+    // total number of 2-edge-connected components
+    int count = 0;
+};
+
+template <typename Graph>
+BridgeResult findBridgesAndArticulationPoints(Graph const &graph)
+{
+    typedef decltype(graph.neighbors(0).begin()) ArcIterator;
+
+    // one frame of the simulated recursion
+    struct Frame
+    {
+        int v, parent;
+        ArcIterator next;
+
+        // whether the arc back to `parent` has been skipped already
+        bool skippedParent;
+    };
+
+    int n = graph.numVertices();
+
+    BridgeResult result;
+    result.component.assign(n, -1);
+
+    std::vector<int> arrival(n, -1), low(n);
+    DenseBitset isArticulation(n);
+
+    // visited vertices whose 2-edge-connected component is not known yet
+    std::vector<int> pending;
+    std::vector<Frame> stack;
+    int time = 0;
+
+    for (int root = 0; root < n; root++)
+    {
+        if (arrival[root] != -1) {
+            continue;
+        }
+
+        auto enter = [&](int v, int parent)
+        {
+            arrival[v] = low[v] = time++;
+            pending.push_back(v);
+            stack.push_back({ v, parent, graph.neighbors(v).begin(), false });
+        };
+
+        int rootChildren = 0;
+        enter(root, -1);
+
+        while (!stack.empty())
+        {
+            Frame &frame = stack.back();
+            int v = frame.v;
+
+            if (frame.next != graph.neighbors(v).end())
+            {
+                int w = *frame.next;
+                ++frame.next;
+
+                if (w == frame.parent && !frame.skippedParent) {
+                    frame.skippedParent = true;
+                }
+                else if (arrival[w] == -1)
+                {
+                    // tree edge: descend into `w`
+                    rootChildren += v == root;
+                    enter(w, v);
+                }
+                else {
+                    // back edge
+                    low[v] = std::min(low[v], arrival[w]);
+                }
+                continue;
+            }
+
+            // all arcs of `v` are scanned; return from `v` to its parent
+            int parent = frame.parent;
+            stack.pop_back();
+
+            // nothing below `v` reaches above it, so the edge to its parent
+            // is a bridge and `v` heads a 2-edge-connected component made of
+            // the pending vertices visited from `v` on
+            if (low[v] == arrival[v])
+            {
+                if (parent != -1) {
+                    result.bridges.push_back({ parent, v });
+                }
+
+                int w;
+                do {
+                    w = pending.back();
+                    pending.pop_back();
+                    result.component[w] = result.count;
+                } while (w != v);
+
+                result.count++;
+            }
+
+            if (parent != -1)
+            {
+                low[parent] = std::min(low[parent], low[v]);
+
+                // removing a non-root `parent` cuts the subtree of `v` off
+                if (parent != root && low[v] >= arrival[parent]) {
+                    isArticulation.set(parent);
+                }
+            }
+        }
+
+        // the root is an articulation point if it has more than one child
+        if (rootChildren > 1) {
+            isArticulation.set(root);
+        }
+    }
+
+    for (std::size_t v = isArticulation.findNext(0); v < (std::size_t) n;
+            v = isArticulation.findNext(v + 1)) {
+        result.articulationPoints.push_back(v);
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include "csr_graph.h"
+
+// Compressed adjacency storage for graphs too large for plain CSR.
+//
+// Every neighbor list is sorted and stored as a byte stream:
+//
+//   degree  first  gap  gap  ...
+//
+// where `first` is the first neighbor minus the vertex itself (zigzag
+// encoded, as it may be negative) and every gap is the difference to the
+// previous neighbor, which is never negative in a sorted list. All numbers
+// are LEB128 varints: 7 bits per byte, the high bit set on every byte but
+// the last. Real graphs number related vertices close to each other, so
+// most gaps fit in one byte, against 4 bytes per neighbor in `CSRGraph`.
+//
+// The start of each vertex's stream is found with a two-level index: one
+// 64-bit byte offset per block of 64 vertices, and one 32-bit offset
+// relative to its block per vertex. This costs 4 + 8 / 64, about 4.1 bytes
+// per vertex instead of the 8 of a `size_t` offsets array (or the 24 of an
+// empty `vector`).
+//
+// Neighbors are decoded on the fly by a forward iterator, so `neighbors(v)`
+// works in range-based for loops like the other graph types, and the
+// traversals written against `numVertices()`, `degree(v)` and
+// `neighbors(v)` run on this graph unchanged. Reverse iteration is not
+// offered: a varint stream can only be read front to back.
+
+// Forward iterator decoding one gap-encoded neighbor list
+class CompressedNeighborIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef int const *pointer;
+    typedef int reference;
+
+    CompressedNeighborIterator() = default;
+
+    // `p` points at the encoded first neighbor of `v`, which has `remaining`
+    // neighbors; `remaining == 0` gives the end iterator
+    CompressedNeighborIterator(std::uint8_t const *p, std::size_t remaining, int v)
+        : p(p), remaining(remaining)
+    {
+        if (remaining > 0)
+        {
+            std::uint64_t zigzag = readVarint(this->p);
+            current = v + (std::int64_t) ((zigzag >> 1) ^ (0 - (zigzag & 1)));
+        }
+    }
+
+    int operator*() const { return (int) current; }
+
+    CompressedNeighborIterator &operator++()
+    {
+        if (--remaining > 0) {
+            current += readVarint(p);
+        }
+        return *this;
+    }
+
+    CompressedNeighborIterator operator++(int)
+    {
+        CompressedNeighborIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    // iterators over the same list are equal when as many neighbors are left
+    bool operator==(CompressedNeighborIterator const &other) const {
+        return remaining == other.remaining;
+    }
+    bool operator!=(CompressedNeighborIterator const &other) const {
+        return remaining != other.remaining;
+    }
+
+    // Decode one LEB128 varint at `p` and move `p` past it. Gaps of one byte
+    // are by far the most common, so they take the first branch.
+    static std::uint64_t readVarint(std::uint8_t const *&p)
+    {
+        std::uint64_t value = *p++;
+        if (value < 0x80) {
+            return value;
+        }
+
+        value &= 0x7f;
+        for (int shift = 7;; shift += 7)
+        {
+            std::uint64_t byte = *p++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+    }
+
+private:
+    std::uint8_t const *p = nullptr;
+    std::size_t remaining = 0;
+    std::int64_t current = 0;
+};
+
+// The neighbors of one vertex of a `CompressedGraph`, in increasing order
+class CompressedNeighborRange
+{
+public:
+    typedef CompressedNeighborIterator iterator;
+
+    CompressedNeighborRange(std::uint8_t const *p, std::size_t count, int v)
+        : p(p), count(count), v(v) {}
+
+    iterator begin() const { return iterator(p, count, v); }
+    iterator end() const { return iterator(); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    std::uint8_t const *p;
+    std::size_t count;
+    int v;
+};
+
+class CompressedGraph
+{
+public:
+    typedef int vertex_type;
+
+    // an empty graph with no vertices
+    CompressedGraph() = default;
+
+    // Compress any graph offering `numVertices()` and `neighbors(v)`, such
+    // as `CSRGraph` or `MappedCSRGraph`. Each neighbor list is sorted before
+    // encoding, so neighbors come out in increasing order.
+    template <typename Graph>
+    explicit CompressedGraph(Graph const &graph)
+    {
+        int n = graph.numVertices();
+        vertices = n;
+        blockStart.reserve(n / BLOCK + 1);
+        vertexStart.reserve(n);
+
+        std::vector<std::int32_t> list;
+        for (int v = 0; v < n; v++)
+        {
+            list.clear();
+            for (auto u: graph.neighbors(v)) {
+                list.push_back(u);
+            }
+            std::sort(list.begin(), list.end());
+            append(v, list.data(), list.size());
+        }
+
+        bytes.shrink_to_fit();
+    }
+
+    // Graph Constructor
+    // Encodes the arcs of the edges (both ways if `Undirected`, as
+    // `CSRGraph` does) without building a CSR graph first: one pass over
+    // `edges` counts the arcs of every vertex, a second one counting-sorts
+    // all the arcs by source into one array of 32-bit targets, and each list
+    // is then sorted and encoded. Besides the encoded graph, the build takes
+    // 4 bytes per arc and 8 bytes per vertex, all freed at the end.
+    template <typename EdgeList>
+    CompressedGraph(EdgeList const &edges, int n, EdgeDirection direction)
+    {
+        vertices = n;
+        blockStart.reserve(n / BLOCK + 1);
+        vertexStart.reserve(n);
+
+        // after the prefix sum `next[v + 1]` is the end of the list of `v`;
+        // arcs are placed from the end down, which leaves it at the start
+        std::vector<std::size_t> next(n + 1, 0);
+        for (auto const &edge: edges)
+        {
+            next[edgeSource(edge) + 1]++;
+            if (direction == Undirected) {
+                next[edgeTarget(edge) + 1]++;
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            next[v + 1] += next[v];
+        }
+
+        std::vector<std::int32_t> targets(next[n]);
+        for (auto const &edge: edges)
+        {
+            int u = edgeSource(edge), v = edgeTarget(edge);
+            targets[--next[u + 1]] = v;
+            if (direction == Undirected) {
+                targets[--next[v + 1]] = u;
+            }
+        }
+
+        for (int v = 0; v < n; v++)
+        {
+            std::int32_t *list = targets.data() + next[v + 1];
+            std::size_t count = (v + 1 < n ? next[v + 2] : targets.size()) - next[v + 1];
+            std::sort(list, list + count);
+            append(v, list, count);
+        }
+
+        bytes.shrink_to_fit();
+    }
+
+    // total number of vertices in the graph
+    int numVertices() const { return vertices; }
+
+    // total number of stored arcs
+    std::size_t numArcs() const { return arcs; }
+
+    // number of arcs leaving vertex `v`
+    std::size_t degree(int v) const
+    {
+        std::uint8_t const *p = start(v);
+        return CompressedNeighborIterator::readVarint(p);
+    }
+
+    // the neighbors of vertex `v`, in increasing order
+    CompressedNeighborRange neighbors(int v) const
+    {
+        std::uint8_t const *p = start(v);
+        std::size_t count = CompressedNeighborIterator::readVarint(p);
+        return CompressedNeighborRange(p, count, v);
+    }
+
+    // bytes taken by the encoded lists and their index
+    std::size_t memoryBytes() const
+    {
+        return bytes.size() + blockStart.size() * sizeof(std::uint64_t)
+                + vertexStart.size() * sizeof(std::uint32_t);
+    }
+
+private:
+    // vertices per block of the offset index
+    static const int BLOCK = 64;
+
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::uint64_t> blockStart;
+    std::vector<std::uint32_t> vertexStart;
+    int vertices = 0;
+    std::size_t arcs = 0;
+
+    // encode the sorted neighbor list of `v`, the next vertex
+    void append(int v, std::int32_t const *list, std::size_t count)
+    {
+        if (v % BLOCK == 0) {
+            blockStart.push_back(bytes.size());
+        }
+
+        std::size_t relative = bytes.size() - blockStart.back();
+        if (relative > UINT32_MAX) {
+            throw std::length_error("CompressedGraph: 64 neighbor lists exceed 4 GiB");
+        }
+        vertexStart.push_back((std::uint32_t) relative);
+
+        writeVarint(count);
+        if (count > 0)
+        {
+            std::int64_t first = std::int64_t(list[0]) - v;
+            writeVarint(((std::uint64_t) first << 1) ^ (std::uint64_t) (first >> 63));
+        }
+        for (std::size_t i = 1; i < count; i++) {
+            writeVarint(std::int64_t(list[i]) - list[i - 1]);
+        }
+
+        arcs += count;
+    }
+
+    std::uint8_t const *start(int v) const
+    {
+        return bytes.data() + blockStart[v / BLOCK] + vertexStart[v];
+    }
+
+    void writeVarint(std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back((std::uint8_t) (value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back((std::uint8_t) value);
+    }
+};
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef CSR_FILE_H
+#define CSR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "mapped_file.h"
+
+// A versioned binary file format holding a graph in CSR form, so that a
+// graph parsed once can be reloaded without parsing or copying anything.
+//
+// Layout (all integers in the byte order of the host that wrote the file,
+// which the header records in `byteOrder`; a host of the other byte order
+// rejects the file instead of converting it):
+//
+//   header      `CSRFileHeader`, 48 bytes
+//   offsets     `numVertices + 1` × uint64, where arc `i` leaves vertex `v`
+//               if `offsets[v] <= i < offsets[v + 1]`
+//   targets     `numArcs` × vertex id of `idWidth` bytes (4 or 8)
+//   weights     `numArcs` × int32, only if the `CSR_FILE_WEIGHTED` flag is set
+//
+// Every array starts at a multiple of 8 bytes, so once the file is
+// memory-mapped each one can be used in place. `MappedCSRGraph` does just
+// that: opening a graph costs one mmap call, a few header checks and one
+// sequential pass over the offsets (8 bytes per vertex) to check that every
+// neighbor range lies inside the targets. The targets are trusted, not read:
+// a corrupt file may hold ids of vertices that do not exist, which
+// `checkTargets()` catches in one more pass, over the targets, for files
+// from a source that is not trusted. Pages of the targets and weights are
+// only read from disk (or the page cache) when touched.
+
+const char CSR_FILE_MAGIC[8] = { 'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H' };
+const std::uint32_t CSR_FILE_VERSION = 2;
+
+// `byteOrder` of the header, as written by the host; it reads 0x04030201 on
+// a host of the other byte order
+const std::uint32_t CSR_FILE_BYTE_ORDER = 0x01020304;
+
+// `flags` bit: the file carries one weight per arc
+const std::uint32_t CSR_FILE_WEIGHTED = 1;
+
+struct CSRFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t idWidth;
+    std::uint32_t flags;
+    std::uint32_t byteOrder;
+    std::uint64_t numVertices;
+    std::uint64_t numArcs;
+    std::uint64_t padding;
+};
+
+static_assert(sizeof(CSRFileHeader) == 48, "CSR file header must be 48 bytes");
+
+namespace csr_file_detail
+{
+
+// round `n` up to a multiple of 8
+inline std::uint64_t align8(std::uint64_t n) { return (n + 7) & ~std::uint64_t(7); }
+
+inline void writeZeros(std::ofstream &out, std::uint64_t count)
+{
+    char const zeros[8] = {};
+    out.write(zeros, count);
+}
+
+}
+
+// Write `graph` to `path`. `Graph` is any graph type offering
+// `numVertices()` and `neighbors(v)`; the targets are stored with the width
+// of `VertexId`, and a target that is not a vertex of the graph or does not
+// fit in a `VertexId` is rejected. `weights`, if given, holds one weight per
+// arc in the same order as the arcs are enumerated by `neighbors`.
+template <typename VertexId = std::uint32_t, typename Graph>
+void writeCSRFile(std::string const &path, Graph const &graph,
+        std::vector<std::int32_t> const *weights = nullptr)
+{
+    using namespace csr_file_detail;
+
+    std::uint64_t n = graph.numVertices();
+
+    // offsets are computed from the neighbor ranges, so the graph does not
+    // need to be stored as CSR itself
+    std::vector<std::uint64_t> offsets(n + 1, 0);
+    for (std::uint64_t v = 0; v < n; v++)
+    {
+        std::uint64_t degree = 0;
+        for (auto u: graph.neighbors(v))
+        {
+            (void) u;
+            degree++;
+        }
+        offsets[v + 1] = offsets[v] + degree;
+    }
+
+    if (weights && weights->size() != offsets[n]) {
+        throw std::invalid_argument("writeCSRFile: one weight per arc expected");
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot create " + path);
+    }
+
+    CSRFileHeader header = {};
+    std::memcpy(header.magic, CSR_FILE_MAGIC, sizeof header.magic);
+    header.version = CSR_FILE_VERSION;
+    header.idWidth = sizeof(VertexId);
+    header.flags = weights ? CSR_FILE_WEIGHTED : 0;
+    header.byteOrder = CSR_FILE_BYTE_ORDER;
+    header.numVertices = n;
+    header.numArcs = offsets[n];
+
+    out.write(reinterpret_cast<char const *>(&header), sizeof header);
+    out.write(reinterpret_cast<char const *>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+
+    // the targets go out one vertex at a time, converted to `VertexId`
+    std::vector<VertexId> buffer;
+    for (std::uint64_t v = 0; v < n; v++)
+    {
+        buffer.clear();
+        for (auto u: graph.neighbors(v))
+        {
+            if (!std::in_range<VertexId>(u) || std::uint64_t(u) >= n) {
+                throw std::out_of_range("writeCSRFile: vertex id " + std::to_string(u)
+                        + " does not fit in " + std::to_string(sizeof(VertexId)) + " bytes"
+                        + " or is not a vertex of the graph");
+            }
+            buffer.push_back(static_cast<VertexId>(u));
+        }
+        out.write(reinterpret_cast<char const *>(buffer.data()), buffer.size() * sizeof(VertexId));
+    }
+
+    std::uint64_t targetBytes = offsets[n] * sizeof(VertexId);
+    writeZeros(out, align8(targetBytes) - targetBytes);
+
+    if (weights)
+    {
+        std::uint64_t weightBytes = weights->size() * sizeof(std::int32_t);
+        out.write(reinterpret_cast<char const *>(weights->data()), weightBytes);
+        writeZeros(out, align8(weightBytes) - weightBytes);
+    }
+
+    if (!out.flush()) {
+        throw std::runtime_error("cannot write " + path);
+    }
+}
+
+// A read-only CSR graph backed directly by a memory-mapped CSR file.
+// It offers the same `numVertices()`, `numArcs()`, `degree(v)` and
+// `neighbors(v)` as `CSRGraph`, so every algorithm in this directory runs on
+// it unchanged. `VertexId` must match the id width the file was written with.
+template <typename VertexId = std::uint32_t>
+class MappedCSRGraph
+{
+public:
+    typedef VertexId vertex_type;
+
+    explicit MappedCSRGraph(std::string const &path): file(path, MADV_NORMAL)
+    {
+        using namespace csr_file_detail;
+
+        CSRFileHeader header;
+        if (file.size() < sizeof header) {
+            throw std::runtime_error(path + " is not a CSR graph file");
+        }
+        std::memcpy(&header, file.begin(), sizeof header);
+
+        if (std::memcmp(header.magic, CSR_FILE_MAGIC, sizeof header.magic) != 0) {
+            throw std::runtime_error(path + " is not a CSR graph file");
+        }
+        if (header.version != CSR_FILE_VERSION) {
+            throw std::runtime_error(path + ": unsupported CSR file version "
+                    + std::to_string(header.version));
+        }
+        if (header.byteOrder != CSR_FILE_BYTE_ORDER) {
+            throw std::runtime_error(path + ": written on a host of another byte order");
+        }
+        if (header.idWidth != sizeof(VertexId)) {
+            throw std::runtime_error(path + ": vertex ids are " + std::to_string(header.idWidth)
+                    + " bytes wide, expected " + std::to_string(sizeof(VertexId)));
+        }
+
+        vertices = header.numVertices;
+        arcs = header.numArcs;
+
+        // every vertex and arc takes at least one byte, which also keeps the
+        // size computations below from overflowing on a corrupt header
+        if (vertices >= file.size() || arcs >= file.size()) {
+            throw std::runtime_error(path + ": truncated or corrupt CSR graph file");
+        }
+
+        std::uint64_t offsetBytes = (vertices + 1) * sizeof(std::uint64_t);
+        std::uint64_t targetBytes = align8(arcs * sizeof(VertexId));
+        std::uint64_t weightBytes = header.flags & CSR_FILE_WEIGHTED
+                ? align8(arcs * sizeof(std::int32_t)) : 0;
+
+        if (file.size() != sizeof header + offsetBytes + targetBytes + weightBytes) {
+            throw std::runtime_error(path + ": truncated or corrupt CSR graph file");
+        }
+
+        char const *base = file.begin() + sizeof header;
+        offsetArray = reinterpret_cast<std::uint64_t const *>(base);
+        targetArray = reinterpret_cast<VertexId const *>(base + offsetBytes);
+        weightArray = weightBytes
+                ? reinterpret_cast<std::int32_t const *>(base + offsetBytes + targetBytes)
+                : nullptr;
+
+        // the offsets must start at 0, never decrease and end at `arcs`, so
+        // that every neighbor range lies inside the target array; one pass
+        // over the offsets, the targets themselves are not read
+        if (offsetArray[0] != 0 || offsetArray[vertices] != arcs) {
+            throw std::runtime_error(path + ": truncated or corrupt CSR graph file");
+        }
+        for (std::uint64_t v = 0; v < vertices; v++)
+        {
+            if (offsetArray[v] > offsetArray[v + 1]) {
+                throw std::runtime_error(path + ": corrupt offsets in CSR graph file");
+            }
+        }
+    }
+
+    int numVertices() const { return (int) vertices; }
+
+    std::size_t numArcs() const { return arcs; }
+
+    std::size_t degree(int v) const { return offsetArray[v + 1] - offsetArray[v]; }
+
+    NeighborRange<VertexId> neighbors(int v) const
+    {
+        return NeighborRange<VertexId>(targetArray + offsetArray[v],
+                targetArray + offsetArray[v + 1]);
+    }
+
+    // Check that every target is a vertex of the graph, in one pass over the
+    // targets; the constructor does not read them
+    void checkTargets() const
+    {
+        for (std::uint64_t i = 0; i < arcs; i++)
+        {
+            if (std::uint64_t(targetArray[i]) >= vertices) {
+                throw std::runtime_error("CSR graph file: arc " + std::to_string(i)
+                        + " leads to vertex " + std::to_string(targetArray[i])
+                        + ", past the last vertex");
+            }
+        }
+    }
+
+    bool hasWeights() const { return weightArray != nullptr; }
+
+    // the weights of the arcs leaving `v`, in the order of `neighbors(v)`;
+    // only valid if `hasWeights()`
+    NeighborRange<std::int32_t> weights(int v) const
+    {
+        return NeighborRange<std::int32_t>(weightArray + offsetArray[v],
+                weightArray + offsetArray[v + 1]);
+    }
+
+private:
+    MappedFile file;
+    std::uint64_t vertices = 0, arcs = 0;
+    std::uint64_t const *offsetArray = nullptr;
+    VertexId const *targetArray = nullptr;
+    std::int32_t const *weightArray = nullptr;
+};
+
+#endif
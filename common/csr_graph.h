@@ -0,0 +1,164 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Compressed sparse row (CSR) graph shared by the traversal problems.
+//
+// Instead of one `vector<int>` per vertex, every neighbor list is stored back
+// to back in one `targets` array, and the neighbors of vertex `v` are
+// `targets[offsets[v]] ... targets[offsets[v + 1] - 1]`. Building the graph
+// costs one allocation per array instead of one per vertex, and scanning the
+// neighbors of a vertex reads consecutive memory.
+//
+// `VertexId` is the integer type stored for each neighbor; use `uint32_t` on
+// graphs with less than 2^32 vertices to halve the size of `targets`
+// compared to a 64-bit id. The vertex count has the same type as the ids,
+// so a graph holds as many vertices as its `VertexId` can number.
+
+// Whether each input edge `(u, v)` is stored as the arc `u → v` only, or as
+// both `u → v` and `v → u`
+enum EdgeDirection { Undirected, Directed };
+
+// Read the endpoints of the edge types used throughout the problems:
+// `struct Edge { int src, dest; }`, `struct Edge { int src, dest, weight; }`
+// and `typedef pair<int, int> Edge`
+template <typename E>
+inline auto edgeSource(E const &edge) -> decltype(edge.src) { return edge.src; }
+
+template <typename E>
+inline auto edgeTarget(E const &edge) -> decltype(edge.dest) { return edge.dest; }
+
+template <typename U, typename V>
+inline U edgeSource(std::pair<U, V> const &edge) { return edge.first; }
+
+template <typename U, typename V>
+inline V edgeTarget(std::pair<U, V> const &edge) { return edge.second; }
+
+// A contiguous run of neighbor ids; works in range-based for loops and
+// supports reverse iteration like `vector<int>` does
+template <typename VertexId>
+class NeighborRange
+{
+public:
+    typedef VertexId const *iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+    NeighborRange(iterator first, iterator last): first(first), last(last) {}
+
+    iterator begin() const { return first; }
+    iterator end() const { return last; }
+    reverse_iterator rbegin() const { return reverse_iterator(last); }
+    reverse_iterator rend() const { return reverse_iterator(first); }
+
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    VertexId operator[](std::size_t i) const { return first[i]; }
+
+private:
+    iterator first, last;
+};
+
+template <typename VertexId = int>
+class CSRGraph
+{
+public:
+    typedef VertexId vertex_type;
+
+    // `offsets[v]` is the position in `targets` of the first neighbor of `v`.
+    // It holds `n + 1` entries, so `offsets[n]` is the total number of arcs.
+    std::vector<std::size_t> offsets;
+
+    // neighbor lists of all vertices, stored back to back
+    std::vector<VertexId> targets;
+
+    // an empty graph with no vertices
+    CSRGraph(): offsets(1, 0) {}
+
+    // Graph Constructor
+    // Counts the out-degree of every vertex, turns the degrees into offsets
+    // with a prefix sum, then scatters each arc into its slot. Arcs are
+    // scattered in input order, so every neighbor list comes out in the same
+    // order the `push_back` based `vector<vector<int>>` graphs produce.
+    template <typename EdgeList>
+    CSRGraph(EdgeList const &edges, std::size_t n, EdgeDirection direction)
+        : offsets(n + 1, 0)
+    {
+        // count the arcs leaving every vertex
+        for (auto const &edge: edges)
+        {
+            offsets[edgeSource(edge) + 1]++;
+            if (direction == Undirected) {
+                offsets[edgeTarget(edge) + 1]++;
+            }
+        }
+
+        // prefix sum of the degrees gives the start of every neighbor list
+        for (std::size_t v = 0; v < n; v++) {
+            offsets[v + 1] += offsets[v];
+        }
+
+        // place every arc at the next free slot of its source vertex
+        targets.resize(offsets[n]);
+        std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+
+        for (auto const &edge: edges)
+        {
+            targets[next[edgeSource(edge)]++] = edgeTarget(edge);
+            if (direction == Undirected) {
+                targets[next[edgeTarget(edge)]++] = edgeSource(edge);
+            }
+        }
+    }
+
+    // total number of vertices in the graph
+    VertexId numVertices() const { return VertexId(offsets.size() - 1); }
+
+    // total number of stored arcs (twice the edge count for undirected input)
+    std::size_t numArcs() const { return targets.size(); }
+
+    // number of arcs leaving vertex `v`
+    std::size_t degree(std::size_t v) const { return offsets[v + 1] - offsets[v]; }
+
+    // the neighbors of vertex `v`, in insertion order
+    NeighborRange<VertexId> neighbors(std::size_t v) const
+    {
+        VertexId const *base = targets.data();
+        return NeighborRange<VertexId>(base + offsets[v], base + offsets[v + 1]);
+    }
+
+    // Build the transpose graph, i.e., the same vertices with the direction
+    // of every arc reversed. The in-neighbors of `v` come out ordered by
+    // source vertex.
+    CSRGraph transpose() const
+    {
+        std::size_t n = numVertices();
+        CSRGraph reversed;
+        reversed.offsets.assign(n + 1, 0);
+
+        for (VertexId u: targets) {
+            reversed.offsets[u + 1]++;
+        }
+
+        for (std::size_t v = 0; v < n; v++) {
+            reversed.offsets[v + 1] += reversed.offsets[v];
+        }
+
+        reversed.targets.resize(targets.size());
+        std::vector<std::size_t> next(reversed.offsets.begin(), reversed.offsets.end() - 1);
+
+        for (std::size_t v = 0; v < n; v++)
+        {
+            for (VertexId u: neighbors(v)) {
+                reversed.targets[next[u]++] = VertexId(v);
+            }
+        }
+
+        return reversed;
+    }
+};
+
+#endif
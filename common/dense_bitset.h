@@ -0,0 +1,251 @@
+#ifndef DENSE_BITSET_H
+#define DENSE_BITSET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size dense bitsets for visited and frontier sets.
+//
+// Unlike `vector<bool>`, the 64-bit words are exposed, so a membership test
+// or update is a single word operation with no proxy reference in between,
+// and whole-set operations (counting, union, difference, scanning for the
+// next member) run 64 positions at a time.
+//
+// `AtomicBitset` offers the same interface with atomic words for parallel
+// traversals, where `testAndSet` doubles as a claim: exactly one thread sees
+// it return false for a given position.
+
+// number of 64-bit words needed to hold `n` bits
+inline std::size_t bitsetWords(std::size_t n) { return (n + 63) / 64; }
+
+class DenseBitset
+{
+public:
+    explicit DenseBitset(std::size_t n = 0): bits(n), words(bitsetWords(n)) {}
+
+    // number of positions in the set
+    std::size_t size() const { return bits; }
+
+    bool test(std::size_t i) const
+    {
+        return (words[i >> 6] >> (i & 63)) & 1;
+    }
+
+    bool operator[](std::size_t i) const { return test(i); }
+
+    void set(std::size_t i) { words[i >> 6] |= bit(i); }
+
+    void reset(std::size_t i) { words[i >> 6] &= ~bit(i); }
+
+    // set position `i` and return whether it was already set
+    bool testAndSet(std::size_t i)
+    {
+        std::uint64_t &word = words[i >> 6];
+        bool wasSet = word & bit(i);
+        word |= bit(i);
+        return wasSet;
+    }
+
+    // reset every position
+    void clear()
+    {
+        for (std::uint64_t &word: words) {
+            word = 0;
+        }
+    }
+
+    // number of set positions
+    std::size_t count() const
+    {
+        std::size_t total = 0;
+        for (std::uint64_t word: words) {
+            total += __builtin_popcountll(word);
+        }
+        return total;
+    }
+
+    // first set position at or after `i`, or `size()` if there is none
+    std::size_t findNext(std::size_t i) const
+    {
+        if (i >= bits) {
+            return bits;
+        }
+
+        std::size_t w = i >> 6;
+        std::uint64_t word = words[w] & (~std::uint64_t(0) << (i & 63));
+
+        while (word == 0)
+        {
+            if (++w == words.size()) {
+                return bits;
+            }
+            word = words[w];
+        }
+
+        return (w << 6) + __builtin_ctzll(word);
+    }
+
+    // first unset position at or after `i`, or `size()` if there is none
+    std::size_t findNextUnset(std::size_t i) const
+    {
+        if (i >= bits) {
+            return bits;
+        }
+
+        std::size_t w = i >> 6;
+        std::uint64_t word = ~words[w] & (~std::uint64_t(0) << (i & 63));
+
+        while (word == 0)
+        {
+            if (++w == words.size()) {
+                return bits;
+            }
+            word = ~words[w];
+        }
+
+        std::size_t position = (w << 6) + __builtin_ctzll(word);
+        return position < bits ? position : bits;
+    }
+
+    // set union, intersection and difference with a bitset of the same size
+    DenseBitset &operator|=(DenseBitset const &other)
+    {
+        for (std::size_t w = 0; w < words.size(); w++) {
+            words[w] |= other.words[w];
+        }
+        return *this;
+    }
+
+    DenseBitset &operator&=(DenseBitset const &other)
+    {
+        for (std::size_t w = 0; w < words.size(); w++) {
+            words[w] &= other.words[w];
+        }
+        return *this;
+    }
+
+    DenseBitset &andNot(DenseBitset const &other)
+    {
+        for (std::size_t w = 0; w < words.size(); w++) {
+            words[w] &= ~other.words[w];
+        }
+        return *this;
+    }
+
+    bool none() const
+    {
+        for (std::uint64_t word: words)
+        {
+            if (word) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // raw word access for algorithms working 64 positions at a time;
+    // bits past `size()` in the last word must be kept at zero
+    std::size_t numWords() const { return words.size(); }
+    std::uint64_t *data() { return words.data(); }
+    std::uint64_t const *data() const { return words.data(); }
+
+private:
+    static std::uint64_t bit(std::size_t i) { return std::uint64_t(1) << (i & 63); }
+
+    std::size_t bits;
+    std::vector<std::uint64_t> words;
+};
+
+class AtomicBitset
+{
+public:
+    explicit AtomicBitset(std::size_t n = 0): bits(n), words(bitsetWords(n))
+    {
+        clear();
+    }
+
+    std::size_t size() const { return bits; }
+
+    bool test(std::size_t i) const
+    {
+        return (words[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+    }
+
+    bool operator[](std::size_t i) const { return test(i); }
+
+    void set(std::size_t i)
+    {
+        words[i >> 6].fetch_or(bit(i), std::memory_order_relaxed);
+    }
+
+    void reset(std::size_t i)
+    {
+        words[i >> 6].fetch_and(~bit(i), std::memory_order_relaxed);
+    }
+
+    // atomically set position `i` and return whether it was already set;
+    // the plain read first skips the read-modify-write for set positions
+    bool testAndSet(std::size_t i)
+    {
+        std::atomic<std::uint64_t> &word = words[i >> 6];
+        if (word.load(std::memory_order_relaxed) & bit(i)) {
+            return true;
+        }
+        return word.fetch_or(bit(i), std::memory_order_relaxed) & bit(i);
+    }
+
+    // reset every position; not safe to call while other threads update the set
+    void clear()
+    {
+        for (std::atomic<std::uint64_t> &word: words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t count() const
+    {
+        std::size_t total = 0;
+        for (std::atomic<std::uint64_t> const &word: words) {
+            total += __builtin_popcountll(word.load(std::memory_order_relaxed));
+        }
+        return total;
+    }
+
+    std::size_t findNext(std::size_t i) const
+    {
+        if (i >= bits) {
+            return bits;
+        }
+
+        std::size_t w = i >> 6;
+        std::uint64_t word = words[w].load(std::memory_order_relaxed)
+                & (~std::uint64_t(0) << (i & 63));
+
+        while (word == 0)
+        {
+            if (++w == words.size()) {
+                return bits;
+            }
+            word = words[w].load(std::memory_order_relaxed);
+        }
+
+        return (w << 6) + __builtin_ctzll(word);
+    }
+
+    std::size_t numWords() const { return words.size(); }
+
+    std::uint64_t word(std::size_t w) const
+    {
+        return words[w].load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::uint64_t bit(std::size_t i) { return std::uint64_t(1) << (i & 63); }
+
+    std::size_t bits;
+    std::vector<std::atomic<std::uint64_t>> words;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef DIRECTION_OPTIMIZING_BFS_H
+#define DIRECTION_OPTIMIZING_BFS_H
+
+#include <cstddef>
+#include <vector>
+#include "bfs_result.h"
+#include "dense_bitset.h"
+
+// Direction-optimizing breadth-first search (Beamer, Asanović and Patterson).
+//
+// A classic BFS expands the frontier top-down: every vertex of the frontier
+// scans all its arcs looking for undiscovered vertices. On low-diameter
+// graphs the middle levels hold most of the graph, so nearly every arc gets
+// checked even though most targets are already discovered. A bottom-up step
+// turns this around: every undiscovered vertex scans its in-neighbors and
+// stops at the first one found in the frontier. The search switches between
+// the two per level, based on how many arcs each direction would have to
+// examine.
+//
+// `Graph` is any graph type offering `numVertices()`, `numArcs()`,
+// `degree(v)` and `neighbors(v)`, such as `CSRGraph`.
+
+// Switching thresholds; the defaults are the values suggested by Beamer et al.
+struct BFSTuning
+{
+    // go bottom-up once the frontier has more than 1/alpha of the arcs that
+    // still lead to undiscovered vertices
+    std::size_t alpha = 15;
+
+    // go back to top-down once the frontier is shrinking and holds less
+    // than 1/beta of all vertices
+    std::size_t beta = 18;
+};
+
+// Perform a direction-optimizing BFS from vertex `source`.
+// `reverse` must be the transpose of `graph`; for an undirected graph pass
+// the graph itself.
+template <typename Graph>
+BFSResult directionOptimizingBFS(Graph const &graph, Graph const &reverse,
+        int source, BFSTuning const &tuning = BFSTuning())
+{
+    int n = graph.numVertices();
+
+    BFSResult result;
+    result.distance.assign(n, -1);
+    result.parent.assign(n, -1);
+
+    // the current frontier as a list (top-down) and as a bitmap (bottom-up)
+    std::vector<int> frontier, next;
+    DenseBitset inFrontier(n);
+
+    result.distance[source] = 0;
+    frontier.push_back(source);
+
+    // arcs out of the frontier, and in-arcs of still undiscovered vertices;
+    // these estimate the work of a top-down and a bottom-up step respectively
+    std::size_t frontierArcs = graph.degree(source);
+    std::size_t unexploredArcs = reverse.numArcs() - reverse.degree(source);
+
+    BFSDirection direction = TopDown;
+    std::size_t previousSize = 0;
+
+    for (int depth = 0; !frontier.empty(); depth++)
+    {
+        bool growing = frontier.size() > previousSize;
+
+        if (direction == TopDown)
+        {
+            if (growing && frontierArcs > unexploredArcs / tuning.alpha) {
+                direction = BottomUp;
+            }
+        }
+        else if (!growing && frontier.size() < n / tuning.beta) {
+            direction = TopDown;
+        }
+
+        BFSLevel level = { depth, direction, frontier.size(), 0 };
+        next.clear();
+
+        if (direction == TopDown)
+        {
+            // every frontier vertex claims its undiscovered neighbors
+            for (int u: frontier)
+            {
+                for (int v: graph.neighbors(u))
+                {
+                    level.arcsExamined++;
+                    if (result.distance[v] == -1)
+                    {
+                        result.distance[v] = depth + 1;
+                        result.parent[v] = u;
+                        next.push_back(v);
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (int u: frontier) {
+                inFrontier.set(u);
+            }
+
+            // every undiscovered vertex looks for a parent in the frontier
+            // and stops scanning at the first one
+            for (int v = 0; v < n; v++)
+            {
+                if (result.distance[v] != -1) {
+                    continue;
+                }
+
+                for (int u: reverse.neighbors(v))
+                {
+                    level.arcsExamined++;
+                    if (inFrontier.test(u))
+                    {
+                        result.distance[v] = depth + 1;
+                        result.parent[v] = u;
+                        next.push_back(v);
+                        break;
+                    }
+                }
+            }
+
+            inFrontier.clear();
+        }
+
+        result.levels.push_back(level);
+
+        frontierArcs = 0;
+        for (int v: next)
+        {
+            frontierArcs += graph.degree(v);
+            unexploredArcs -= reverse.degree(v);
+        }
+
+        previousSize = frontier.size();
+        frontier.swap(next);
+    }
+
+    return result;
+}
+
+#endif
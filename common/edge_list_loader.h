@@ -0,0 +1,275 @@
+#ifndef EDGE_LIST_LOADER_H
+#define EDGE_LIST_LOADER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+#include "mapped_file.h"
+#include "parallel_csr_builder.h"
+#include "thread_pool.h"
+
+// Loading graphs from text edge lists.
+//
+// The expected format is one edge per line, "u v" or "u v w" with
+// non-negative integer vertex ids and an optional integer weight, separated
+// by spaces or tabs. Empty lines and lines starting with '#' or '%' (the
+// comment markers of SNAP and Matrix Market dumps) are skipped, and both
+// "\n" and "\r\n" line endings are accepted.
+//
+// The file is memory-mapped and parsed in place with `std::from_chars`, so
+// no line is ever copied into a `std::string`; the only allocation is the
+// edge vector itself. Errors are reported as `std::runtime_error`.
+//
+// `loadEdgeListParallel` cuts the mapped file into newline-aligned chunks
+// and parses them on all threads of a pool, each chunk into its own
+// buffer; the buffers are then copied into the final vector at offsets
+// given by a prefix sum of their sizes, so no lock is taken.
+
+// An edge as read from the file; `weight` is 1 when the line has none.
+// It has the same `src` / `dest` layout as the problems' edges, so it can be
+// passed to the `CSRGraph` constructor directly.
+struct LoadedEdge
+{
+    int src, dest, weight;
+};
+
+struct EdgeList
+{
+    std::vector<LoadedEdge> edges;
+
+    // one more than the largest vertex id found
+    int numVertices = 0;
+
+    // whether any line carried a weight
+    bool weighted = false;
+
+    // whether each edge stands for one arc or for arcs in both directions
+    EdgeDirection direction = Directed;
+};
+
+namespace edge_list_detail
+{
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+[[noreturn]] inline void malformedLine(char const *begin, char const *at)
+{
+    std::size_t line = 1 + std::count(begin, at, '\n');
+    throw std::runtime_error("malformed edge list at line " + std::to_string(line));
+}
+
+}
+
+// Parse the edge list in [first, last) and call `add(edge, hasWeight)` for
+// every edge. `origin` is the start of the whole buffer, only used to report
+// the line number of a malformed line.
+template <typename Add>
+void parseEdgeList(char const *first, char const *last, char const *origin, Add &&add)
+{
+    using namespace edge_list_detail;
+
+    char const *p = first;
+    while (p < last)
+    {
+        while (p < last && isBlank(*p)) {
+            p++;
+        }
+
+        // empty line or comment: skip to the next line
+        if (p == last || *p == '\n' || *p == '#' || *p == '%')
+        {
+            p = std::find(p, last, '\n');
+            if (p < last) {
+                p++;
+            }
+            continue;
+        }
+
+        LoadedEdge edge = { 0, 0, 1 };
+        bool hasWeight = false;
+
+        auto parsed = std::from_chars(p, last, edge.src);
+        if (parsed.ec != std::errc() || edge.src < 0) {
+            malformedLine(origin, p);
+        }
+        p = parsed.ptr;
+
+        while (p < last && isBlank(*p)) {
+            p++;
+        }
+
+        parsed = std::from_chars(p, last, edge.dest);
+        if (parsed.ec != std::errc() || edge.dest < 0) {
+            malformedLine(origin, p);
+        }
+        p = parsed.ptr;
+
+        while (p < last && isBlank(*p)) {
+            p++;
+        }
+
+        if (p < last && *p != '\n')
+        {
+            parsed = std::from_chars(p, last, edge.weight);
+            if (parsed.ec != std::errc()) {
+                malformedLine(origin, p);
+            }
+            p = parsed.ptr;
+            hasWeight = true;
+
+            while (p < last && isBlank(*p)) {
+                p++;
+            }
+        }
+
+        if (p < last && *p != '\n') {
+            malformedLine(origin, p);
+        }
+        if (p < last) {
+            p++;
+        }
+
+        add(edge, hasWeight);
+    }
+}
+
+// Load all edges of a text edge-list file
+inline EdgeList loadEdgeList(std::string const &path)
+{
+    MappedFile file(path);
+    EdgeList list;
+
+    // every edge takes one line, so the line count bounds the edge count;
+    // counting newlines runs at memory speed and avoids any reallocation
+    list.edges.reserve(std::count(file.begin(), file.end(), '\n') + 1);
+
+    parseEdgeList(file.begin(), file.end(), file.begin(),
+            [&](LoadedEdge const &edge, bool hasWeight)
+    {
+        list.edges.push_back(edge);
+        list.numVertices = std::max(list.numVertices, std::max(edge.src, edge.dest) + 1);
+        list.weighted = list.weighted || hasWeight;
+    });
+
+    return list;
+}
+
+// Load a text edge-list file straight into a CSR graph; the graph has one
+// vertex per id up to the largest id found
+template <typename VertexId = int>
+CSRGraph<VertexId> loadGraph(std::string const &path, EdgeDirection direction)
+{
+    EdgeList list = loadEdgeList(path);
+    return CSRGraph<VertexId>(list.edges, list.numVertices, direction);
+}
+
+// Load all edges of a text edge-list file using every thread of `pool`.
+// The edges come out in file order, exactly as `loadEdgeList` returns them;
+// `direction` is recorded in the result for building the graph.
+inline EdgeList loadEdgeListParallel(std::string const &path, ThreadPool &pool,
+        EdgeDirection direction = Directed)
+{
+    MappedFile file(path);
+    char const *origin = file.begin();
+    std::size_t size = file.size();
+
+    // a few chunks per thread, so that threads finishing early can help
+    // with the rest; each boundary is moved past the next newline so that
+    // no line is split between two chunks
+    std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(4 * pool.size(),
+            size / (1 << 16)));
+    std::vector<char const *> boundary(chunks + 1);
+
+    boundary[0] = origin;
+    boundary[chunks] = file.end();
+    for (std::size_t c = 1; c < chunks; c++)
+    {
+        char const *p = std::max(origin + size * c / chunks, boundary[c - 1]);
+        p = std::find(p, file.end(), '\n');
+        boundary[c] = p < file.end() ? p + 1 : p;
+    }
+
+    struct Chunk
+    {
+        std::vector<LoadedEdge> edges;
+        int numVertices = 0;
+        bool weighted = false;
+        std::exception_ptr error;
+    };
+    std::vector<Chunk> parts(chunks);
+
+    pool.parallelFor(chunks, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t c = begin; c < end; c++)
+        {
+            Chunk &part = parts[c];
+            try
+            {
+                part.edges.reserve(std::count(boundary[c], boundary[c + 1], '\n') + 1);
+                parseEdgeList(boundary[c], boundary[c + 1], origin,
+                        [&](LoadedEdge const &edge, bool hasWeight)
+                {
+                    part.edges.push_back(edge);
+                    part.numVertices = std::max(part.numVertices,
+                            std::max(edge.src, edge.dest) + 1);
+                    part.weighted = part.weighted || hasWeight;
+                });
+            }
+            catch (...) {
+                // rethrown on the calling thread below
+                part.error = std::current_exception();
+            }
+        }
+    });
+
+    EdgeList list;
+    list.direction = direction;
+
+    std::vector<std::size_t> position(chunks + 1, 0);
+    for (std::size_t c = 0; c < chunks; c++)
+    {
+        if (parts[c].error) {
+            std::rethrow_exception(parts[c].error);
+        }
+        position[c + 1] = position[c] + parts[c].edges.size();
+        list.numVertices = std::max(list.numVertices, parts[c].numVertices);
+        list.weighted = list.weighted || parts[c].weighted;
+    }
+
+    // concatenate the chunk buffers, each copied by one thread
+    list.edges.resize(position[chunks]);
+    pool.parallelFor(chunks, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t c = begin; c < end; c++)
+        {
+            std::copy(parts[c].edges.begin(), parts[c].edges.end(),
+                    list.edges.begin() + position[c]);
+            std::vector<LoadedEdge>().swap(parts[c].edges);
+        }
+    });
+
+    return list;
+}
+
+// Build the CSR graph of a loaded edge list, with the direction it was
+// loaded with
+template <typename VertexId = int>
+CSRGraph<VertexId> buildGraph(EdgeList const &list)
+{
+    return CSRGraph<VertexId>(list.edges, list.numVertices, list.direction);
+}
+
+// Build the CSR graph of a loaded edge list on all threads of `pool`, with
+// the direction it was loaded with; neighbor lists come out sorted
+template <typename VertexId = int>
+CSRGraph<VertexId> buildGraph(EdgeList const &list, ThreadPool &pool)
+{
+    return buildCSRGraphParallel<VertexId>(list.edges, list.numVertices, list.direction, pool);
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// A 2D grid stored in one contiguous row-major array, surrounded by a
+// one-cell ring of sentinel cells.
+//
+// Cell (i, j), for 0 <= i < rows() and 0 <= j < cols(), lives at index
+// `(i + 1) × stride() + j + 1`, with `stride() == cols() + 2`. Moving by
+// (di, dj) therefore always adds the same constant `di × stride() + dj` to
+// the index, whatever the cell, and the neighbor offsets of a search can be
+// computed once with `neighborOffsets`. The border ring holds a value the
+// algorithm treats as blocked (water, a wall, a color that is never filled),
+// so every neighbor of an interior cell is a valid index and the usual
+// `isValid` / `isSafe` bounds checks disappear from the inner loops: the
+// border cell simply fails the same test as a blocked cell.
+//
+// Searches that need a visited mark per cell can index a `DenseBitset` of
+// `size()` bits with the same indices.
+
+// which cells count as adjacent: the 4 sharing a side, or also the 4 diagonal
+// ones
+enum GridConnectivity { FourConnected = 4, EightConnected = 8 };
+
+template <typename T>
+class Grid
+{
+public:
+    // an empty grid with no cells
+    Grid() = default;
+
+    // a `rows × cols` grid with every cell set to `fill`, and `border` in
+    // the sentinel ring
+    Grid(int rows, int cols, T border, T fill)
+        : rowCount(rows), colCount(cols),
+          cells(std::size_t(rows + 2) * (cols + 2), fill)
+    {
+        fillBorder(border);
+    }
+
+    // copy a `vector<vector<U>>` matrix, as used by the problems, into a
+    // grid with `border` in the sentinel ring
+    template <typename U>
+    Grid(std::vector<std::vector<U>> const &mat, T border)
+        : Grid(mat.size(), mat.empty() ? 0 : mat[0].size(), border, border)
+    {
+        for (int i = 0; i < rowCount; i++)
+        {
+            for (int j = 0; j < colCount; j++) {
+                (*this)(i, j) = mat[i][j];
+            }
+        }
+    }
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+
+    // distance in the array between two vertically adjacent cells
+    std::ptrdiff_t stride() const { return colCount + 2; }
+
+    // total number of cells including the border ring
+    std::size_t size() const { return cells.size(); }
+
+    // index of cell (i, j)
+    std::size_t index(int i, int j) const { return std::size_t(i + 1) * stride() + j + 1; }
+
+    // row and column of the cell at `index`
+    int rowOf(std::size_t index) const { return int(index / stride()) - 1; }
+    int colOf(std::size_t index) const { return int(index % stride()) - 1; }
+
+    T &operator[](std::size_t index) { return cells[index]; }
+    T const &operator[](std::size_t index) const { return cells[index]; }
+
+    T &operator()(int i, int j) { return cells[index(i, j)]; }
+    T const &operator()(int i, int j) const { return cells[index(i, j)]; }
+
+    T *data() { return cells.data(); }
+    T const *data() const { return cells.data(); }
+
+    // store `value` in every cell of the border ring
+    void fillBorder(T value)
+    {
+        std::ptrdiff_t width = stride();
+        for (std::ptrdiff_t j = 0; j < width; j++)
+        {
+            cells[j] = value;
+            cells[(rowCount + 1) * width + j] = value;
+        }
+        for (int i = 1; i <= rowCount; i++)
+        {
+            cells[i * width] = value;
+            cells[i * width + width - 1] = value;
+        }
+    }
+
+    // Turn the movement arrays of a problem, such as `row[] = { -1, 0, 0, 1 }`
+    // and `col[] = { 0, -1, 1, 0 }`, into index offsets in the same order
+    template <std::size_t K>
+    std::array<std::ptrdiff_t, K> neighborOffsets(int const (&rowDelta)[K],
+            int const (&colDelta)[K]) const
+    {
+        std::array<std::ptrdiff_t, K> offsets;
+        for (std::size_t k = 0; k < K; k++) {
+            offsets[k] = rowDelta[k] * stride() + colDelta[k];
+        }
+        return offsets;
+    }
+
+    // the grid without its border, as a `vector<vector<T>>` matrix
+    std::vector<std::vector<T>> toMatrix() const
+    {
+        std::vector<std::vector<T>> mat(rowCount, std::vector<T>(colCount));
+        for (int i = 0; i < rowCount; i++)
+        {
+            for (int j = 0; j < colCount; j++) {
+                mat[i][j] = (*this)(i, j);
+            }
+        }
+        return mat;
+    }
+
+private:
+    int rowCount = 0, colCount = 0;
+    std::vector<T> cells;
+};
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef GRID_SEARCH_H
+#define GRID_SEARCH_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "grid.h"
+
+// Point-to-point shortest paths in a maze, 4-connected moves of cost 1.
+//
+// The maze is a `Grid` whose open cells are nonzero and whose border ring is
+// 0, as for Lee's algorithm, and cells are given by their grid index. A BFS
+// from the source explores every cell closer than the target, in all
+// directions; both searches here are A* with the Manhattan distance to the
+// target as heuristic, which is exact on an empty grid and never
+// overestimates, so the length found is still the shortest.
+//
+// `f = g + h` (distance so far plus heuristic) never decreases along the
+// search and only takes small integer values, so the open list is a bucket
+// queue indexed by `f` instead of a binary heap: pushing and popping are
+// O(1). Within a bucket, the most recently pushed entry comes out first,
+// which follows one of the many equally short paths of an open area to the
+// end instead of widening all of them.
+//
+// `jumpPoint` adds jump-point search (Harabor and Grastien) for 4-connected
+// grids. Of all the shortest paths through open space it only follows the
+// canonical ones, that go vertically and branch off horizontally, and turn
+// from a horizontal run only where a wall ends (a forced neighbor). Runs
+// are scanned cell by cell without touching the queue, and only their end
+// points (jump points) are pushed and expanded.
+//
+// `aStarPathLength` and `jumpPointPathLength` answer a single query;
+// `GridPathSearch` keeps the search state for many queries on one maze.
+
+struct GridSearchResult
+{
+    // number of moves on a shortest path, or -1 if there is none
+    int length = -1;
+
+    // number of queue entries expanded: cells for A*, jump points for JPS
+    std::size_t expanded = 0;
+};
+
+// Min-priority queue of items with small nonnegative integer keys, for
+// searches that never push a key smaller than the last one popped. Items of
+// equal key come out last in, first out.
+template <typename Item>
+class BucketQueue
+{
+public:
+    bool empty() const { return count == 0; }
+
+    void push(int key, Item item)
+    {
+        if (std::size_t(key) >= buckets.size()) {
+            buckets.resize(key + 1);
+        }
+        buckets[key].push_back(item);
+        count++;
+    }
+
+    Item pop()
+    {
+        while (buckets[current].empty()) {
+            current++;
+        }
+        Item item = buckets[current].back();
+        buckets[current].pop_back();
+        count--;
+        return item;
+    }
+
+    // remove all items; the buckets keep their memory for the next search
+    void clear()
+    {
+        for (std::size_t key = current; key < buckets.size(); key++) {
+            buckets[key].clear();
+        }
+        current = count = 0;
+    }
+
+private:
+    std::vector<std::vector<Item>> buckets;
+    std::size_t current = 0, count = 0;
+};
+
+namespace grid_search_detail
+{
+
+// Manhattan distance between two cells of `grid`
+template <typename T>
+int manhattan(Grid<T> const &grid, std::size_t a, std::size_t b)
+{
+    return std::abs(grid.rowOf(a) - grid.rowOf(b)) + std::abs(grid.colOf(a) - grid.colOf(b));
+}
+
+}
+
+// Point-to-point searches in one maze. The search state of every cell (best
+// known distance, closed or not) is allocated on the first query and kept,
+// each entry tagged with the number of the query that last wrote it; an
+// entry with an older tag reads as unset, so a query only costs the cells
+// it touches instead of O(cells) of setup.
+template <typename T>
+class GridPathSearch
+{
+public:
+    explicit GridPathSearch(Grid<T> const &maze): maze(maze) {}
+
+    // Shortest path length from `source` to `target` by A* with the
+    // Manhattan heuristic
+    GridSearchResult aStar(std::size_t source, std::size_t target)
+    {
+        using grid_search_detail::manhattan;
+
+        GridSearchResult result;
+        if (!maze[source] || !maze[target]) {
+            return result;
+        }
+        start(maze.size());
+
+        int row[] = { -1, 0, 0, 1 };
+        int col[] = { 0, -1, 1, 0 };
+        auto moves = maze.neighborOffsets(row, col);
+
+        // an entry may be pushed again with a smaller distance, and the
+        // stale one is skipped
+        setDist(source, 0);
+        queue.push(manhattan(maze, source, target), source);
+
+        while (!queue.empty())
+        {
+            std::size_t cell = queue.pop();
+            if (close(cell)) {
+                continue;
+            }
+            result.expanded++;
+
+            int g = dist(cell);
+            if (cell == target)
+            {
+                result.length = g;
+                break;
+            }
+
+            for (std::ptrdiff_t move: moves)
+            {
+                std::size_t next = cell + move;
+                if (maze[next] && g + 1 < dist(next))
+                {
+                    setDist(next, g + 1);
+                    queue.push(g + 1 + manhattan(maze, next, target), next);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // Shortest path length from `source` to `target` by jump-point search;
+    // the same length as `aStar` and Lee's algorithm, with far fewer cells
+    // pushed on open ground
+    GridSearchResult jumpPoint(std::size_t source, std::size_t target)
+    {
+        using grid_search_detail::manhattan;
+
+        GridSearchResult result;
+        if (!maze[source] || !maze[target]) {
+            return result;
+        }
+
+        // a state is a jump point and the direction it was reached in,
+        // `cell × 4 + direction`: the directions to go on in depend on it,
+        // and the same cell may be reached both ways at the same distance
+        start(maze.size() * 4);
+
+        std::ptrdiff_t stride = maze.stride();
+
+        // directions 0 and 3 are vertical, 1 and 2 horizontal
+        std::ptrdiff_t const step[] = { -stride, -1, 1, stride };
+        std::size_t const none = maze.size();
+
+        auto open = [&](std::size_t cell) { return maze[cell] != 0; };
+
+        // Walk a horizontal run from `cell`; stop at the target, or at a
+        // cell that has an open cell above or below where the previous one
+        // had a wall, since paths branching off there are not covered by
+        // any other run. Return the cell stopped at, or `none` at a dead end.
+        auto jumpHorizontal = [&](std::size_t cell, std::ptrdiff_t d)
+        {
+            for (;;)
+            {
+                cell += d;
+                if (!open(cell)) {
+                    return none;
+                }
+                if (cell == target) {
+                    return cell;
+                }
+                if ((open(cell - stride) && !open(cell - d - stride)) ||
+                        (open(cell + stride) && !open(cell - d + stride))) {
+                    return cell;
+                }
+            }
+        };
+
+        // Walk a vertical run from `cell`; every cell of it branches off
+        // both ways horizontally, so stop where one of those branches
+        // reaches a jump point
+        auto jumpVertical = [&](std::size_t cell, std::ptrdiff_t d)
+        {
+            for (;;)
+            {
+                cell += d;
+                if (!open(cell)) {
+                    return none;
+                }
+                if (cell == target || jumpHorizontal(cell, -1) != none ||
+                        jumpHorizontal(cell, 1) != none) {
+                    return cell;
+                }
+            }
+        };
+
+        // jump from `cell`, at distance `g`, in direction `k`, and push the
+        // jump point found, if any
+        auto jump = [&](std::size_t cell, int g, int k)
+        {
+            std::size_t next = k == 0 || k == 3 ? jumpVertical(cell, step[k])
+                    : jumpHorizontal(cell, step[k]);
+            if (next == none) {
+                return;
+            }
+
+            int nextDist = g + manhattan(maze, cell, next);
+            if (nextDist < dist(next * 4 + k))
+            {
+                setDist(next * 4 + k, nextDist);
+                queue.push(nextDist + manhattan(maze, next, target), next * 4 + k);
+            }
+        };
+
+        result.expanded++;
+        if (source == target)
+        {
+            result.length = 0;
+            return result;
+        }
+        for (int k = 0; k < 4; k++) {
+            jump(source, 0, k);
+        }
+
+        while (!queue.empty())
+        {
+            std::size_t state = queue.pop();
+            if (close(state)) {
+                continue;
+            }
+            result.expanded++;
+
+            std::size_t cell = state / 4;
+            int k = state % 4, g = dist(state);
+            if (cell == target)
+            {
+                result.length = g;
+                break;
+            }
+
+            // go on in the same direction; a vertical run also branches off
+            // both ways, and a horizontal one turns where it was forced to
+            jump(cell, g, k);
+            if (k == 0 || k == 3)
+            {
+                jump(cell, g, 1);
+                jump(cell, g, 2);
+            }
+            else
+            {
+                std::ptrdiff_t d = step[k];
+                if (open(cell - stride) && !open(cell - d - stride)) {
+                    jump(cell, g, 0);
+                }
+                if (open(cell + stride) && !open(cell - d + stride)) {
+                    jump(cell, g, 3);
+                }
+            }
+        }
+
+        return result;
+    }
+
+private:
+    // `dist` is valid if `seen` is the current query, and the state is
+    // closed if `closed` is
+    struct State
+    {
+        int dist;
+        std::uint32_t seen, closed;
+    };
+
+    Grid<T> const &maze;
+    std::vector<State> states;
+    std::uint32_t query = 0;
+    BucketQueue<std::size_t> queue;
+
+    // begin a query over states 0 .. count - 1
+    void start(std::size_t count)
+    {
+        if (states.size() < count) {
+            states.resize(count, State{ INT_MAX, 0, 0 });
+        }
+
+        // after 2^32 queries the tags wrap around, and the old ones must go
+        if (++query == 0)
+        {
+            for (State &state: states) {
+                state.seen = state.closed = 0;
+            }
+            query = 1;
+        }
+        queue.clear();
+    }
+
+    int dist(std::size_t state) const
+    {
+        return states[state].seen == query ? states[state].dist : INT_MAX;
+    }
+
+    void setDist(std::size_t state, int d)
+    {
+        states[state].dist = d;
+        states[state].seen = query;
+    }
+
+    // close `state` and report whether it already was
+    bool close(std::size_t state)
+    {
+        if (states[state].closed == query) {
+            return true;
+        }
+        states[state].closed = query;
+        return false;
+    }
+};
+
+// Shortest path length from `source` to `target` by A*, for a single query:
+// the search state is allocated for the call and freed on return
+template <typename T>
+GridSearchResult aStarPathLength(Grid<T> const &maze, std::size_t source,
+        std::size_t target)
+{
+    return GridPathSearch<T>(maze).aStar(source, target);
+}
+
+// Same as `aStarPathLength`, by jump-point search
+template <typename T>
+GridSearchResult jumpPointPathLength(Grid<T> const &maze, std::size_t source,
+        std::size_t target)
+{
+    return GridPathSearch<T>(maze).jumpPoint(source, target);
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef ISLAND_LABELING_H
+#define ISLAND_LABELING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bit_grid.h"
+#include "grid.h"
+#include "union_find.h"
+
+// Connected-component labeling of a bit-packed binary raster by runs.
+//
+// Each row is cut into runs of consecutive 1 cells with `forEachRun`, which
+// skips 64 cells per word over water and through the inside of long runs.
+// A run is merged (union-find) with every run of the row above that touches
+// it: overlapping columns for 4-connectivity, or columns at most one apart
+// for 8-connectivity, since a diagonal step reaches the next column. The
+// runs of two consecutive rows are both sorted by column, so the touching
+// pairs are found by one merge-like sweep. The work is linear in the number
+// of words plus the number of runs, and the memory is one `IslandRun` and
+// one union-find entry per run, never per cell.
+//
+// Run and island numbers are 64-bit, so the only size limits are those of
+// the raster itself: fewer than 2^31 rows and 2^31 columns. A random 50%
+// mask has about cols / 4 runs per row, some 2.5 billion runs on 100k ×
+// 100k, which is past `int` but also 12 bytes of `IslandRun` plus 16 bytes
+// of union-find and label per run, some 70 GB. This is for callers that
+// need the labels; the count alone (`countIslands`) and the island sizes
+// come from the two-row sweep of `streaming_islands.h` in O(cols) memory.
+
+// One run of 1 cells: columns [begin, end) of row `row`
+struct IslandRun
+{
+    int row, begin, end;
+};
+
+struct IslandLabels
+{
+    // all runs in row-major order
+    std::vector<IslandRun> runs;
+
+    // `label[r]` is the island of run `r`, from 0 to `count - 1`, numbered
+    // in the order of their first cell in row-major order
+    std::vector<std::int64_t> label;
+
+    // total number of islands
+    std::int64_t count = 0;
+};
+
+inline IslandLabels labelIslandRuns(BitGrid const &grid, GridConnectivity connectivity)
+{
+    IslandLabels result;
+    UnionFind sets;
+
+    // runs touching each other may be one column apart with 8-connectivity
+    int reach = connectivity == EightConnected ? 1 : 0;
+
+    // the runs of the previous row are [above, current) in `result.runs`
+    std::size_t above = 0;
+
+    for (int i = 0; i < grid.rows(); i++)
+    {
+        std::size_t current = result.runs.size();
+
+        forEachRun(grid.row(i), grid.cols(), [&](int begin, int end)
+        {
+            std::int64_t r = sets.add();
+            result.runs.push_back({ i, begin, end });
+
+            // skip the runs above that end too far left to touch this one;
+            // they cannot touch any later run of this row either
+            while (above < current && result.runs[above].end + reach <= begin) {
+                above++;
+            }
+
+            // merge with every run above that starts early enough; the last
+            // of them may also touch the next run of this row, so `above`
+            // stays on it
+            for (std::size_t a = above; a < current && result.runs[a].begin < end + reach; a++) {
+                sets.unite(a, r);
+            }
+        });
+
+        above = current;
+    }
+
+    // number the islands in the order of their first run
+    result.label.resize(result.runs.size());
+    for (std::size_t r = 0; r < result.runs.size(); r++) {
+        result.label[r] = sets.isRoot(r) ? result.count++ : result.label[sets.find(r)];
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef KNIGHT_DISTANCE_H
+#define KNIGHT_DISTANCE_H
+
+#include <cstdlib>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Minimum number of knight moves between two squares of an N × N board,
+// in O(1) per query.
+//
+// On an unbounded board the distance has a closed form in the coordinate
+// differences (x, y), taken with x >= y >= 0: with d = x - y, it is
+// d + 2 × ceil((y - d) / 3) when y > d and d - 2 × floor((d - y) / 4)
+// otherwise, except for the two cases (1, 0) → 3 and (2, 2) → 4. On a board
+// of N >= 5 the edges only get in the way in one case: between a corner and
+// the square diagonally next to it, which takes 4 moves instead of 2.
+// Boards smaller than 5 × 5 are irregular (some squares cannot be reached
+// at all), so their distances are precomputed into a table by BFS; that
+// table has at most 4^4 entries.
+//
+// `knightDistancesFrom` is the plain BFS, on a flat array instead of a set
+// of visited squares, for checking the formula and for small boards.
+
+// distance between two squares (x, y) apart on an unbounded board
+inline int knightDistanceUnbounded(int x, int y)
+{
+    x = std::abs(x);
+    y = std::abs(y);
+    if (x < y) {
+        std::swap(x, y);
+    }
+
+    if (x == 1 && y == 0) {
+        return 3;
+    }
+    if (x == 2 && y == 2) {
+        return 4;
+    }
+
+    int d = x - y;
+    if (y > d) {
+        return d + 2 * ((y - d + 2) / 3);
+    }
+    return d - 2 * ((d - y) / 4);
+}
+
+// Distances by BFS from square (x, y) to every square of an `n × n` board,
+// `dist[i × n + j]`, with -1 for the squares that cannot be reached
+inline std::vector<int> knightDistancesFrom(int n, int x, int y)
+{
+    static int const row[] = { 2, 2, -2, -2, 1, 1, -1, -1 };
+    static int const col[] = { -1, 1, 1, -1, 2, -2, 2, -2 };
+
+    std::vector<int> dist(std::size_t(n) * n, -1);
+    std::queue<std::size_t> q;
+
+    dist[std::size_t(x) * n + y] = 0;
+    q.push(std::size_t(x) * n + y);
+
+    while (!q.empty())
+    {
+        std::size_t square = q.front();
+        q.pop();
+
+        int i = square / n, j = square % n;
+        for (int k = 0; k < 8; k++)
+        {
+            int i1 = i + row[k], j1 = j + col[k];
+            std::size_t next = std::size_t(i1) * n + j1;
+            if (i1 >= 0 && i1 < n && j1 >= 0 && j1 < n && dist[next] == -1)
+            {
+                dist[next] = dist[square] + 1;
+                q.push(next);
+            }
+        }
+    }
+
+    return dist;
+}
+
+class KnightDistance
+{
+public:
+    // boards from this size on follow the closed form
+    static constexpr int regularSize = 5;
+
+    explicit KnightDistance(int n): n(n)
+    {
+        if (n >= regularSize) {
+            return;
+        }
+
+        // small board: BFS from every square
+        for (int x = 0; x < n; x++)
+        {
+            for (int y = 0; y < n; y++)
+            {
+                std::vector<int> dist = knightDistancesFrom(n, x, y);
+                table.insert(table.end(), dist.begin(), dist.end());
+            }
+        }
+    }
+
+    int size() const { return n; }
+
+    // moves from (x1, y1) to (x2, y2), or -1 if there is no way
+    int operator()(int x1, int y1, int x2, int y2) const
+    {
+        if (n < regularSize) {
+            return table[((x1 * n + y1) * n + x2) * n + y2];
+        }
+
+        // a corner and its diagonal neighbor
+        if (std::abs(x1 - x2) == 1 && std::abs(y1 - y2) == 1 &&
+                (isCorner(x1, y1) || isCorner(x2, y2))) {
+            return 4;
+        }
+
+        return knightDistanceUnbounded(x1 - x2, y1 - y2);
+    }
+
+private:
+    int n;
+
+    // distance between every pair of squares of a board smaller than
+    // `regularSize`
+    std::vector<int> table;
+
+    bool isCorner(int x, int y) const
+    {
+        return (x == 0 || x == n - 1) && (y == 0 || y == n - 1);
+    }
+};
+
+#endif
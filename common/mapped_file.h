@@ -0,0 +1,70 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A read-only memory mapping of a whole file, unmapped on destruction
+class MappedFile
+{
+public:
+    // `advice` tells the kernel how the mapping will be accessed
+    // (see madvise(2)); the default suits reading the file front to back
+    explicit MappedFile(std::string const &path, int advice = MADV_SEQUENTIAL)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) == -1)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path + ": " + std::strerror(errno));
+        }
+
+        length = info.st_size;
+        if (length > 0)
+        {
+            void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path + ": " + std::strerror(errno));
+            }
+            address = static_cast<char const *>(mapped);
+            ::madvise(mapped, length, advice);
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (address) {
+            ::munmap(const_cast<char *>(address), length);
+        }
+    }
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile const &) = delete;
+
+    char const *begin() const { return address; }
+    char const *end() const { return address + length; }
+    std::size_t size() const { return length; }
+
+private:
+    char const *address = nullptr;
+    std::size_t length = 0;
+};
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef MORPHOLOGICAL_RECONSTRUCTION_H
+#define MORPHOLOGICAL_RECONSTRUCTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "bit_grid.h"
+#include "grid.h"
+
+// Binary morphological reconstruction: the cells of `mask` connected to some
+// cell of `seed` through cells of `mask`, i.e., the seed dilated over and
+// over, clipped to the mask each time, until it stops growing. This is a
+// flood fill from many points at once; "cells connected to the border" is
+// the reconstruction from the border cells.
+//
+// `reconstructByDilation` works on whole bit rows, 64 cells per word
+// operation. Instead of dilating the whole raster per round, it sweeps the
+// rows top to bottom and then bottom to top, updating them in place, so one
+// sweep carries the fill along any path that only goes down (or up), and a
+// round is needed only per change of vertical direction of the paths. Within
+// a row the fill runs through a whole run of mask cells in one word
+// operation: adding the seed bits to the mask bits makes the carry ripple
+// through the 1s of the mask above every seed bit, and the same on the row
+// with its bits reversed covers the other direction. On compact regions this
+// takes a few rounds of O(words) each; a path that winds up and down many
+// times needs as many rounds.
+//
+// `reconstructByQueue` is the ordered-queue algorithm: every cell is reached
+// once, from a FIFO of cells, so the work is O(cells of the raster) whatever
+// the shape of the mask. Each seed cell is flooded from as soon as the scan
+// finds it, and a cell leaves the FIFO once its neighbors are queued, so the
+// FIFO only ever holds the current frontier of one fill, not every cell of
+// the result.
+
+namespace reconstruction_detail
+{
+
+inline std::uint64_t reverseBits(std::uint64_t x)
+{
+    x = ((x >> 1) & 0x5555555555555555) | ((x & 0x5555555555555555) << 1);
+    x = ((x >> 2) & 0x3333333333333333) | ((x & 0x3333333333333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0F) | ((x & 0x0F0F0F0F0F0F0F0F) << 4);
+    return __builtin_bswap64(x);
+}
+
+// Extend the bits of `s` (all inside `m`) towards higher columns through
+// the runs of `m`, in place: `m + s` carries from every seed bit up to the
+// end of its run, flipping the bits it passes, with the carry handed from
+// word to word
+inline void fillUp(std::uint64_t const *m, std::uint64_t *s, std::size_t words)
+{
+    std::uint64_t carry = 0;
+    for (std::size_t w = 0; w < words; w++)
+    {
+        std::uint64_t sum;
+        bool out = __builtin_add_overflow(m[w], s[w], &sum);
+        out |= __builtin_add_overflow(sum, carry, &sum);
+        carry = out;
+
+        s[w] |= (sum ^ m[w]) & m[w];
+    }
+}
+
+// Fill the whole run of `m` through every bit of `s`, in place; `reversedM`
+// and `scratch` hold `words` words each
+inline void fillRuns(std::uint64_t const *m, std::uint64_t *s, std::size_t words,
+        std::uint64_t *reversedM, std::uint64_t *scratch)
+{
+    for (std::size_t w = 0; w < words; w++)
+    {
+        reversedM[w] = reverseBits(m[words - 1 - w]);
+        scratch[w] = reverseBits(s[words - 1 - w]);
+    }
+
+    fillUp(m, s, words);
+    fillUp(reversedM, scratch, words);
+
+    for (std::size_t w = 0; w < words; w++) {
+        s[w] |= reverseBits(scratch[words - 1 - w]);
+    }
+}
+
+// OR into `out` the cells of row `r` and, with 8-connectivity, their left
+// and right neighbors
+inline void spreadRow(std::uint64_t const *r, std::uint64_t *out, std::size_t words,
+        bool diagonal)
+{
+    for (std::size_t w = 0; w < words; w++)
+    {
+        std::uint64_t bits = r[w];
+        if (diagonal)
+        {
+            bits |= (r[w] << 1) | (r[w] >> 1);
+            if (w > 0) {
+                bits |= r[w - 1] >> 63;
+            }
+            if (w + 1 < words) {
+                bits |= r[w + 1] << 63;
+            }
+        }
+        out[w] |= bits;
+    }
+}
+
+}
+
+inline BitGrid reconstructByDilation(BitGrid const &mask, BitGrid const &seed,
+        GridConnectivity connectivity)
+{
+    using namespace reconstruction_detail;
+
+    int rows = mask.rows();
+    std::size_t words = mask.wordsPerRow();
+    bool diagonal = connectivity == EightConnected;
+
+    BitGrid result(rows, mask.cols());
+    for (int i = 0; i < rows; i++)
+    {
+        for (std::size_t w = 0; w < words; w++) {
+            result.row(i)[w] = seed.row(i)[w] & mask.row(i)[w];
+        }
+    }
+
+    std::vector<std::uint64_t> row(words), reversedM(words), scratch(words);
+
+    // update row `i` from the row next to it, `from`, and report a change
+    auto update = [&](int i, int from)
+    {
+        std::uint64_t const *m = mask.row(i);
+        std::uint64_t *x = result.row(i);
+
+        std::copy(x, x + words, row.begin());
+        if (from >= 0 && from < rows) {
+            spreadRow(result.row(from), row.data(), words, diagonal);
+        }
+        for (std::size_t w = 0; w < words; w++) {
+            row[w] &= m[w];
+        }
+        fillRuns(m, row.data(), words, reversedM.data(), scratch.data());
+
+        if (std::equal(row.begin(), row.end(), x)) {
+            return false;
+        }
+        std::copy(row.begin(), row.end(), x);
+        return true;
+    };
+
+    // sweep down and back up until a whole round changes nothing
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (int i = 0; i < rows; i++) {
+            changed |= update(i, i - 1);
+        }
+        for (int i = rows - 1; i >= 0; i--) {
+            changed |= update(i, i + 1);
+        }
+    }
+
+    return result;
+}
+
+inline BitGrid reconstructByQueue(BitGrid const &mask, BitGrid const &seed,
+        GridConnectivity connectivity)
+{
+    int rows = mask.rows(), cols = mask.cols();
+    int moves = connectivity == EightConnected ? 8 : 4;
+
+    // the four side neighbors first, then the diagonal ones
+    static int const row[] = { -1, 0, 0, 1, -1, -1, 1, 1 };
+    static int const col[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
+
+    BitGrid result(rows, cols);
+
+    // a queue entry is a cell index `i × cols + j`; every cell is queued at
+    // most once, when it joins the result
+    std::queue<std::size_t> queue;
+
+    for (int si = 0; si < rows; si++)
+    {
+        for (int sj = 0; sj < cols; sj++)
+        {
+            if (!seed.test(si, sj) || !mask.test(si, sj) || result.test(si, sj)) {
+                continue;
+            }
+
+            result.set(si, sj);
+            queue.push(std::size_t(si) * cols + sj);
+
+            while (!queue.empty())
+            {
+                int i = queue.front() / cols, j = queue.front() % cols;
+                queue.pop();
+
+                for (int k = 0; k < moves; k++)
+                {
+                    int x = i + row[k], y = j + col[k];
+                    if (x >= 0 && x < rows && y >= 0 && y < cols && mask.test(x, y) &&
+                            !result.test(x, y))
+                    {
+                        result.set(x, y);
+                        queue.push(std::size_t(x) * cols + y);
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// The cells of `grid` on its first or last row or column
+inline BitGrid borderCells(BitGrid const &grid)
+{
+    int rows = grid.rows(), cols = grid.cols();
+    BitGrid border(rows, cols);
+
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j: { 0, cols - 1 })
+        {
+            if (j >= 0 && grid.test(i, j)) {
+                border.set(i, j);
+            }
+        }
+    }
+    for (int i: { 0, rows - 1 })
+    {
+        for (int j = 0; i >= 0 && j < cols; j++)
+        {
+            if (grid.test(i, j)) {
+                border.set(i, j);
+            }
+        }
+    }
+
+    return border;
+}
+
+// The cells of `grid` connected to its border through cells of `grid`: the
+// reconstruction of `grid` from its border cells, by `reconstructByQueue`
+// if `orderedQueue` is set and by `reconstructByDilation` otherwise
+inline BitGrid borderConnected(BitGrid const &grid, GridConnectivity connectivity,
+        bool orderedQueue)
+{
+    BitGrid seed = borderCells(grid);
+    return orderedQueue ? reconstructByQueue(grid, seed, connectivity)
+            : reconstructByDilation(grid, seed, connectivity);
+}
+
+#endif
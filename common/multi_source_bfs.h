@@ -0,0 +1,197 @@
+#ifndef MULTI_SOURCE_BFS_H
+#define MULTI_SOURCE_BFS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "dense_bitset.h"
+
+// Bit-parallel multi-source breadth-first search (MS-BFS, Then et al.).
+//
+// Up to 64 × `Words` searches run at the same time, one bit lane per source.
+// Every vertex keeps a lane mask of the searches that have seen it and of
+// the searches that have it in their frontier. Expanding a vertex ORs its
+// frontier mask into all its neighbors, so a single scan of an arc advances
+// every search that currently has the arc's source in its frontier; BFS runs
+// from sources that share parts of the graph share that work.
+//
+// `Graph` is any graph type offering `numVertices()` and `neighbors(v)`,
+// such as `CSRGraph`. Use `Words` = 1, 4 or 8 for batches of 64, 256 or 512
+// sources.
+
+// One bit per source of a batch
+template <std::size_t Words>
+struct SourceLanes
+{
+    std::uint64_t word[Words];
+
+    static SourceLanes none()
+    {
+        SourceLanes lanes;
+        std::fill(lanes.word, lanes.word + Words, 0);
+        return lanes;
+    }
+
+    void set(std::size_t lane) { word[lane >> 6] |= std::uint64_t(1) << (lane & 63); }
+
+    bool test(std::size_t lane) const { return (word[lane >> 6] >> (lane & 63)) & 1; }
+
+    bool any() const
+    {
+        std::uint64_t all = 0;
+        for (std::size_t w = 0; w < Words; w++) {
+            all |= word[w];
+        }
+        return all != 0;
+    }
+
+    SourceLanes &operator|=(SourceLanes const &other)
+    {
+        for (std::size_t w = 0; w < Words; w++) {
+            word[w] |= other.word[w];
+        }
+        return *this;
+    }
+
+    // the lanes of this set that are not in `other`
+    SourceLanes without(SourceLanes const &other) const
+    {
+        SourceLanes lanes;
+        for (std::size_t w = 0; w < Words; w++) {
+            lanes.word[w] = word[w] & ~other.word[w];
+        }
+        return lanes;
+    }
+
+    // call `f(lane)` for every set lane, in increasing order
+    template <typename F>
+    void forEach(F const &f) const
+    {
+        for (std::size_t w = 0; w < Words; w++)
+        {
+            for (std::uint64_t bits = word[w]; bits; bits &= bits - 1) {
+                f((w << 6) + __builtin_ctzll(bits));
+            }
+        }
+    }
+};
+
+// Run one BFS from each of `sources[0] ... sources[count - 1]` together,
+// where `count` is at most 64 × `Words`. Lane `i` belongs to `sources[i]`.
+// `visit(v, depth, lanes)` is called once per vertex and depth at which at
+// least one search first reaches `v`, with the lanes of these searches;
+// depth 0 reports the sources themselves.
+template <std::size_t Words, typename Graph, typename Visitor>
+void multiSourceBFS(Graph const &graph, int const *sources, std::size_t count,
+        Visitor &&visit)
+{
+    typedef SourceLanes<Words> Lanes;
+    int n = graph.numVertices();
+
+    // searches that have reached each vertex, searches that have the vertex
+    // in their current frontier, and searches that reach it on the next level
+    std::vector<Lanes> seen(n, Lanes::none());
+    std::vector<Lanes> current(n, Lanes::none());
+    std::vector<Lanes> next(n, Lanes::none());
+
+    // vertices with a non-empty `current` / `next` mask
+    std::vector<int> frontier, touched;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        int s = sources[i];
+        if (!current[s].any()) {
+            frontier.push_back(s);
+        }
+        current[s].set(i);
+        seen[s].set(i);
+    }
+
+    for (int s: frontier) {
+        visit(s, 0, current[s]);
+    }
+
+    for (int depth = 1; !frontier.empty(); depth++)
+    {
+        // one scan of the arcs of `u` advances all searches in `current[u]`
+        for (int u: frontier)
+        {
+            for (int v: graph.neighbors(u))
+            {
+                if (!next[v].any()) {
+                    touched.push_back(v);
+                }
+                next[v] |= current[u];
+            }
+            current[u] = Lanes::none();
+        }
+
+        frontier.clear();
+
+        // keep only the searches that reach a vertex for the first time
+        for (int v: touched)
+        {
+            Lanes reached = next[v].without(seen[v]);
+            next[v] = Lanes::none();
+
+            if (reached.any())
+            {
+                seen[v] |= reached;
+                current[v] = reached;
+                frontier.push_back(v);
+                visit(v, depth, reached);
+            }
+        }
+
+        touched.clear();
+    }
+}
+
+// Reachability rows for the given sources: bit `v` of row `i` is set if there
+// is a directed path from `sources[i]` to `v` (every source reaches itself).
+// The sources are processed in batches of 64 × `Words`.
+template <std::size_t Words, typename Graph>
+std::vector<DenseBitset> multiSourceReachability(Graph const &graph,
+        std::vector<int> const &sources)
+{
+    int n = graph.numVertices();
+    std::vector<DenseBitset> rows(sources.size(), DenseBitset(n));
+
+    for (std::size_t first = 0; first < sources.size(); first += 64 * Words)
+    {
+        std::size_t count = std::min(sources.size() - first, 64 * Words);
+        multiSourceBFS<Words>(graph, sources.data() + first, count,
+                [&](int v, int, SourceLanes<Words> const &lanes)
+        {
+            lanes.forEach([&](std::size_t lane) { rows[first + lane].set(v); });
+        });
+    }
+
+    return rows;
+}
+
+// Distances from each of the given sources: `distance[i][v]` is the number
+// of edges on a shortest path from `sources[i]` to `v`, or -1 if `v` is not
+// reachable from it. The sources are processed in batches of 64 × `Words`.
+template <std::size_t Words, typename Graph>
+std::vector<std::vector<int>> multiSourceDistances(Graph const &graph,
+        std::vector<int> const &sources)
+{
+    int n = graph.numVertices();
+    std::vector<std::vector<int>> distance(sources.size(), std::vector<int>(n, -1));
+
+    for (std::size_t first = 0; first < sources.size(); first += 64 * Words)
+    {
+        std::size_t count = std::min(sources.size() - first, 64 * Words);
+        multiSourceBFS<Words>(graph, sources.data() + first, count,
+                [&](int v, int depth, SourceLanes<Words> const &lanes)
+        {
+            lanes.forEach([&](std::size_t lane) { distance[first + lane][v] = depth; });
+        });
+    }
+
+    return distance;
+}
+
+#endif
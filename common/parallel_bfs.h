@@ -0,0 +1,123 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "bfs_result.h"
+#include "thread_pool.h"
+
+// Multi-threaded level-synchronous breadth-first search.
+//
+// Every level of the search is expanded in parallel: the frontier is cut
+// into chunks that the threads of the pool take in turn. A thread claims an
+// undiscovered vertex with a compare-and-swap on its parent entry, so each
+// vertex is claimed by exactly one thread, and appends it to its own
+// next-frontier buffer. Once the level is done, the buffers are concatenated
+// into the next frontier, again in parallel. The distances are the same as
+// those of the sequential BFS; the parent of a vertex can be any of its
+// neighbors on the previous level.
+//
+// `Graph` is any graph type offering `numVertices()` and `neighbors(v)`,
+// such as `CSRGraph`.
+
+// number of frontier vertices a thread takes at a time
+const std::size_t PARALLEL_BFS_GRAIN = 256;
+
+template <typename Graph>
+BFSResult parallelBFS(Graph const &graph, int source, ThreadPool &pool)
+{
+    int n = graph.numVertices();
+    unsigned threads = pool.size();
+
+    BFSResult result;
+    result.distance.assign(n, -1);
+
+    // `parent[v]` stays -1 until a thread claims `v`; the source points to
+    // itself while the search runs so that nobody claims it again
+    std::vector<std::atomic<int>> parent(n);
+    pool.parallelFor(n, 1 << 16, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; v++) {
+            parent[v].store(-1, std::memory_order_relaxed);
+        }
+    });
+
+    parent[source].store(source, std::memory_order_relaxed);
+    result.distance[source] = 0;
+
+    std::vector<int> frontier(1, source), next;
+    std::vector<std::vector<int>> local(threads);
+    std::vector<std::size_t> arcs(threads), position(threads + 1);
+
+    for (int depth = 0; !frontier.empty(); depth++)
+    {
+        for (unsigned t = 0; t < threads; t++)
+        {
+            local[t].clear();
+            arcs[t] = 0;
+        }
+
+        // expand the frontier; every thread collects the vertices it claims
+        pool.parallelFor(frontier.size(), PARALLEL_BFS_GRAIN,
+                [&](unsigned t, std::size_t begin, std::size_t end)
+        {
+            std::vector<int> &buffer = local[t];
+            std::size_t examined = 0;
+
+            for (std::size_t i = begin; i < end; i++)
+            {
+                int u = frontier[i];
+                for (int v: graph.neighbors(u))
+                {
+                    examined++;
+
+                    // cheap check first, so that already claimed vertices
+                    // do not cost an atomic read-modify-write
+                    int expected = -1;
+                    if (parent[v].load(std::memory_order_relaxed) == -1 &&
+                        parent[v].compare_exchange_strong(expected, u,
+                                std::memory_order_relaxed))
+                    {
+                        result.distance[v] = depth + 1;
+                        buffer.push_back(v);
+                    }
+                }
+            }
+
+            arcs[t] += examined;
+        });
+
+        BFSLevel level = { depth, TopDown, frontier.size(), 0 };
+        position[0] = 0;
+        for (unsigned t = 0; t < threads; t++)
+        {
+            level.arcsExamined += arcs[t];
+            position[t + 1] = position[t] + local[t].size();
+        }
+        result.levels.push_back(level);
+
+        // concatenate the per-thread buffers into the next frontier
+        next.resize(position[threads]);
+        pool.run([&](unsigned t)
+        {
+            std::copy(local[t].begin(), local[t].end(), next.begin() + position[t]);
+        });
+
+        frontier.swap(next);
+    }
+
+    result.parent.resize(n);
+    pool.parallelFor(n, 1 << 16, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; v++) {
+            result.parent[v] = parent[v].load(std::memory_order_relaxed);
+        }
+    });
+    result.parent[source] = -1;
+
+    return result;
+}
+
+#endif
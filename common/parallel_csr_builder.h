@@ -0,0 +1,216 @@
+#ifndef PARALLEL_CSR_BUILDER_H
+#define PARALLEL_CSR_BUILDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+// Multi-threaded construction of `CSRGraph`, a parallel counting sort of
+// the arcs by source vertex:
+//
+//   1. count the out-degree of every vertex with atomic increments,
+//   2. turn the degrees into offsets with a parallel prefix sum,
+//   3. scatter every arc to the slot given by an atomic cursor per vertex,
+//      the cursors starting at the offsets,
+//   4. optionally sort each neighbor list.
+//
+// Steps 1 and 3 are spread over the input in chunks, step 2 over blocks of
+// vertices, step 4 over vertices. On x86 an atomic increment is a full
+// barrier that waits for earlier stores, so step 3 takes all the slots of a
+// chunk first and writes the targets in a second loop; interleaving the two
+// stalls every increment on the cache miss of the previous target store.
+// With a single thread the increments need no atomicity at all, and plain
+// load/store pairs are used instead.
+//
+// The arcs of a vertex land in its list in whatever order the threads reach
+// them, so the lists are sorted by default to make the graph the same on
+// every run; pass `sortNeighbors = false` when the order does not matter.
+// Note that `CSRGraph`'s own constructor keeps the input order instead.
+
+namespace parallel_csr_detail
+{
+
+// Replace `values[0..n)` by their exclusive prefix sums and store the total
+// in `values[n]`. Each block is summed on its own, the block totals are
+// scanned sequentially, then each block is scanned again from its start.
+inline void prefixSum(std::vector<std::size_t> &values, std::size_t n, ThreadPool &pool)
+{
+    std::size_t blocks = std::max<std::size_t>(1, std::min<std::size_t>(4 * pool.size(),
+            n / 4096));
+    std::vector<std::size_t> blockSum(blocks + 1, 0);
+
+    pool.parallelFor(blocks, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; b++)
+        {
+            std::size_t sum = 0;
+            for (std::size_t i = n * b / blocks; i < n * (b + 1) / blocks; i++) {
+                sum += values[i];
+            }
+            blockSum[b + 1] = sum;
+        }
+    });
+
+    for (std::size_t b = 0; b < blocks; b++) {
+        blockSum[b + 1] += blockSum[b];
+    }
+
+    pool.parallelFor(blocks, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; b++)
+        {
+            std::size_t sum = blockSum[b];
+            for (std::size_t i = n * b / blocks; i < n * (b + 1) / blocks; i++)
+            {
+                std::size_t value = values[i];
+                values[i] = sum;
+                sum += value;
+            }
+        }
+    });
+
+    values[n] = blockSum[blocks];
+}
+
+// The counting sort itself. `items` is the number of input items (edges or
+// vertices), and `forEachArc(i, emit)` calls `emit(source, target)` for
+// every arc contributed by item `i`. It is called three times per item and
+// must emit the same arcs in the same order each time.
+template <typename VertexId, typename ForEachArc>
+CSRGraph<VertexId> buildParallel(std::size_t n, std::size_t items, ForEachArc const &forEachArc,
+        ThreadPool &pool, bool sortNeighbors)
+{
+    const std::size_t grain = 4096;
+
+    CSRGraph<VertexId> graph;
+    std::vector<std::atomic<std::size_t>> cursor(n);
+
+    // return the old value of `counter` and increment it
+    bool shared = pool.size() > 1;
+    auto bump = [shared](std::atomic<std::size_t> &counter)
+    {
+        if (shared) {
+            return counter.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::size_t value = counter.load(std::memory_order_relaxed);
+        counter.store(value + 1, std::memory_order_relaxed);
+        return value;
+    };
+
+    pool.parallelFor(n, grain, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; v++) {
+            cursor[v].store(0, std::memory_order_relaxed);
+        }
+    });
+
+    // 1. out-degrees
+    pool.parallelFor(items, grain, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            forEachArc(i, [&](VertexId source, VertexId) {
+                bump(cursor[source]);
+            });
+        }
+    });
+
+    // 2. offsets; the cursors restart at the first slot of every list
+    graph.offsets.resize(n + 1);
+    pool.parallelFor(n, grain, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; v++) {
+            graph.offsets[v] = cursor[v].load(std::memory_order_relaxed);
+        }
+    });
+
+    prefixSum(graph.offsets, n, pool);
+
+    pool.parallelFor(n, grain, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; v++) {
+            cursor[v].store(graph.offsets[v], std::memory_order_relaxed);
+        }
+    });
+
+    // 3. scatter; every slot is claimed by exactly one arc, so the plain
+    // stores into `targets` do not race
+    graph.targets.resize(graph.offsets[n]);
+    std::vector<std::vector<std::size_t>> slots(pool.size());
+
+    pool.parallelFor(items, grain, [&](unsigned t, std::size_t begin, std::size_t end)
+    {
+        std::vector<std::size_t> &slot = slots[t];
+        slot.clear();
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            forEachArc(i, [&](VertexId source, VertexId) {
+                slot.push_back(bump(cursor[source]));
+            });
+        }
+
+        std::size_t k = 0;
+        for (std::size_t i = begin; i < end; i++)
+        {
+            forEachArc(i, [&](VertexId, VertexId target) {
+                graph.targets[slot[k++]] = target;
+            });
+        }
+    });
+
+    // 4. canonical neighbor order
+    if (sortNeighbors)
+    {
+        pool.parallelFor(n, 256, [&](unsigned, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t v = begin; v < end; v++) {
+                std::sort(graph.targets.begin() + graph.offsets[v],
+                        graph.targets.begin() + graph.offsets[v + 1]);
+            }
+        });
+    }
+
+    return graph;
+}
+
+}
+
+// Build the CSR graph of `edges` on `n` vertices using every thread of
+// `pool`. `edges` is any random-access container of the edge types accepted
+// by `CSRGraph`; with `Undirected`, every edge is stored in both directions.
+template <typename VertexId = int, typename EdgeList>
+CSRGraph<VertexId> buildCSRGraphParallel(EdgeList const &edges, std::size_t n,
+        EdgeDirection direction, ThreadPool &pool, bool sortNeighbors = true)
+{
+    return parallel_csr_detail::buildParallel<VertexId>(n, edges.size(),
+            [&](std::size_t i, auto const &emit)
+    {
+        VertexId source = edgeSource(edges[i]), target = edgeTarget(edges[i]);
+        emit(source, target);
+        if (direction == Undirected) {
+            emit(target, source);
+        }
+    }, pool, sortNeighbors);
+}
+
+// Build the transpose of `graph` using every thread of `pool`; with
+// `sortNeighbors`, the in-neighbors come out ordered by source vertex, as
+// `CSRGraph::transpose()` produces them
+template <typename VertexId>
+CSRGraph<VertexId> transposeParallel(CSRGraph<VertexId> const &graph, ThreadPool &pool,
+        bool sortNeighbors = true)
+{
+    return parallel_csr_detail::buildParallel<VertexId>(graph.numVertices(),
+            graph.numVertices(), [&](std::size_t v, auto const &emit)
+    {
+        for (VertexId u: graph.neighbors(v)) {
+            emit(u, (VertexId) v);
+        }
+    }, pool, sortNeighbors);
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef PARALLEL_ISLAND_LABELING_H
+#define PARALLEL_ISLAND_LABELING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bit_grid.h"
+#include "island_labeling.h"
+#include "thread_pool.h"
+#include "union_find.h"
+
+// Multi-threaded island labeling of a bit-packed raster by tiles.
+//
+// The raster is cut into tiles of whole rows (bands), a few per thread. Each
+// band is labeled independently by the same run-based sweep as
+// `labelIslandRuns`, with a private sequential union-find. The bands are
+// then stitched: the local union-finds are copied into one
+// `ConcurrentUnionFind` at offsets given by a prefix sum of the run counts,
+// and the runs on both sides of every band border are merged in parallel.
+// Since every band keeps the smallest run of a set as its root, and the
+// bands are laid out in row order, the result is exactly the labeling of
+// `labelIslandRuns`: same runs, same island numbers.
+//
+// Bands spanning whole rows keep every run inside a single tile, so the only
+// seams to stitch are horizontal ones, and each border is a single sweep
+// over two rows of runs.
+
+namespace parallel_island_detail
+{
+
+// merge the runs of one row, [above, aboveEnd) in `runs`, with the touching
+// runs of the next row, [below, belowEnd)
+template <typename Sets>
+void stitchRows(std::vector<IslandRun> const &runs, std::size_t above, std::size_t aboveEnd,
+        std::size_t below, std::size_t belowEnd, int reach, Sets &sets)
+{
+    for (std::size_t r = below; r < belowEnd; r++)
+    {
+        while (above < aboveEnd && runs[above].end + reach <= runs[r].begin) {
+            above++;
+        }
+        for (std::size_t a = above; a < aboveEnd && runs[a].begin < runs[r].end + reach; a++) {
+            sets.unite(a, r);
+        }
+    }
+}
+
+}
+
+inline IslandLabels parallelLabelIslandRuns(BitGrid const &grid, GridConnectivity connectivity,
+        ThreadPool &pool)
+{
+    using namespace parallel_island_detail;
+
+    int rows = grid.rows();
+    int reach = connectivity == EightConnected ? 1 : 0;
+
+    // at least 64 rows per band, so that stitching stays cheap
+    std::size_t bands = std::max<std::size_t>(1, std::min<std::size_t>(4 * pool.size(),
+            rows / 64));
+
+    struct Band
+    {
+        int firstRow, lastRow;
+        std::vector<IslandRun> runs;
+        std::vector<std::int64_t> parent;
+
+        // runs of the first and of the last row are [0, firstEnd) and
+        // [lastBegin, runs.size())
+        std::size_t firstEnd = 0, lastBegin = 0;
+    };
+    std::vector<Band> band(bands);
+
+    // phase 1: label every band on its own
+    pool.parallelFor(bands, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; b++)
+        {
+            Band &tile = band[b];
+            tile.firstRow = rows * b / bands;
+            tile.lastRow = rows * (b + 1) / bands;
+
+            UnionFind sets;
+            std::size_t above = 0;
+
+            for (int i = tile.firstRow; i < tile.lastRow; i++)
+            {
+                std::size_t current = tile.runs.size();
+                forEachRun(grid.row(i), grid.cols(), [&](int begin, int end) {
+                    sets.add();
+                    tile.runs.push_back({ i, begin, end });
+                });
+                stitchRows(tile.runs, above, current, current, tile.runs.size(), reach, sets);
+
+                if (i == tile.firstRow) {
+                    tile.firstEnd = tile.runs.size();
+                }
+                tile.lastBegin = current;
+                above = current;
+            }
+
+            tile.parent.resize(tile.runs.size());
+            for (std::size_t r = 0; r < tile.runs.size(); r++) {
+                tile.parent[r] = sets.find(r);
+            }
+        }
+    });
+
+    // phase 2: lay the bands out one after the other
+    std::vector<std::size_t> offset(bands + 1, 0);
+    for (std::size_t b = 0; b < bands; b++) {
+        offset[b + 1] = offset[b] + band[b].runs.size();
+    }
+
+    IslandLabels result;
+    result.runs.resize(offset[bands]);
+    ConcurrentUnionFind sets(offset[bands]);
+
+    pool.parallelFor(bands, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; b++)
+        {
+            std::copy(band[b].runs.begin(), band[b].runs.end(), result.runs.begin() + offset[b]);
+            for (std::size_t r = 0; r < band[b].parent.size(); r++) {
+                sets.initialize(offset[b] + r, offset[b] + band[b].parent[r]);
+            }
+            std::vector<std::int64_t>().swap(band[b].parent);
+        }
+    });
+
+    // phase 3: merge across every band border; borders are independent, but
+    // a set may span several of them, hence the concurrent union-find
+    if (bands > 1)
+    {
+        pool.parallelFor(bands - 1, 1, [&](unsigned, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t b = begin; b < end; b++)
+            {
+                Band const &upper = band[b], &lower = band[b + 1];
+                stitchRows(result.runs, offset[b] + upper.lastBegin, offset[b + 1],
+                        offset[b + 1], offset[b + 1] + lower.firstEnd, reach, sets);
+            }
+        });
+    }
+
+    // phase 4: number the islands in the order of their first run; roots
+    // are counted per band, then non-roots copy the number of their root,
+    // which is always an earlier run
+    std::vector<std::int64_t> roots(bands + 1, 0);
+    result.label.resize(result.runs.size());
+
+    pool.parallelFor(bands, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; b++)
+        {
+            for (std::size_t r = offset[b]; r < offset[b + 1]; r++) {
+                roots[b + 1] += sets.isRoot(r);
+            }
+        }
+    });
+
+    for (std::size_t b = 0; b < bands; b++) {
+        roots[b + 1] += roots[b];
+    }
+    result.count = roots[bands];
+
+    pool.parallelFor(bands, 1, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t b = begin; b < end; b++)
+        {
+            std::int64_t next = roots[b];
+            for (std::size_t r = offset[b]; r < offset[b + 1]; r++)
+            {
+                if (sets.isRoot(r)) {
+                    result.label[r] = next++;
+                }
+            }
+        }
+    });
+
+    pool.parallelFor(result.runs.size(), 4096, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t r = begin; r < end; r++)
+        {
+            if (!sets.isRoot(r)) {
+                result.label[r] = result.label[sets.find(r)];
+            }
+        }
+    });
+
+    return result;
+}
+
+// Expand run labels into a per-cell label map: `map[i × cols + j]` is the
+// island of cell (i, j), or -1 for water. The rows are filled in parallel.
+inline std::vector<std::int64_t> islandLabelMap(IslandLabels const &labels, int rows, int cols,
+        ThreadPool &pool)
+{
+    std::vector<std::int64_t> map(std::size_t(rows) * cols, -1);
+
+    pool.parallelFor(labels.runs.size(), 4096, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t r = begin; r < end; r++)
+        {
+            IslandRun const &run = labels.runs[r];
+            std::fill(map.begin() + std::size_t(run.row) * cols + run.begin,
+                    map.begin() + std::size_t(run.row) * cols + run.end, labels.label[r]);
+        }
+    });
+
+    return map;
+}
+
+#endif
@@ -0,0 +1,427 @@
+#ifndef PARALLEL_SCC_H
+#define PARALLEL_SCC_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "strongly_connected_components.h"
+#include "thread_pool.h"
+
+// Parallel strongly connected components by trimming and forward-backward
+// reachability (Fleischer, Hendrickson and Pınar; Hong, Rodia and Olukotun).
+//
+// Every vertex carries a partition color. The SCC of a pivot is the
+// intersection of the vertices it reaches (forward) and the vertices that
+// reach it (backward) inside its partition, and every other SCC lies
+// entirely inside one of the three remaining parts: forward only, backward
+// only, or neither. These parts get new colors and are processed
+// independently.
+//
+// Graphs such as call graphs tend to have one giant SCC and a huge number of
+// trivial ones, so the work is split in two phases:
+//
+//   1. In parallel, trim every vertex with no in-arcs or no out-arcs (each is
+//      an SCC of its own), then find the SCC of a high-degree pivot with a
+//      parallel level-synchronous BFS in each direction.
+//   2. The parts left over are queued as tasks that the threads of the pool
+//      take in turn. A task repeatedly trims its part with a worklist, which
+//      peels off chains of trivial SCCs in linear time, and then splits what
+//      remains by a sequential forward-backward search, queuing the pieces.
+//
+// The result uses the same `SCCResult` layout as the sequential engine, but
+// component ids are not in topological order.
+//
+// `Graph` is any graph type offering `numVertices()`, `degree(v)` and
+// `neighbors(v)`, such as `CSRGraph`.
+
+namespace parallel_scc_detail
+{
+
+// color of vertices whose component is already known
+const int DONE = -1;
+
+struct Task
+{
+    int color;
+    std::vector<int> members;
+};
+
+// State shared by all threads of one decomposition. A vertex is only ever
+// written by the thread that owns its partition; other threads may read its
+// color while scanning arcs, which is why colors are atomic. Colors are
+// never reused, so reading an old value cannot be mistaken for membership.
+template <typename Graph>
+struct State
+{
+    Graph const &graph, &reverse;
+
+    std::vector<std::atomic<int>> color;
+    std::vector<int> component, inDegree, outDegree;
+
+    std::atomic<int> nextColor, nextComponent;
+
+    State(Graph const &graph, Graph const &reverse)
+        : graph(graph), reverse(reverse), color(graph.numVertices()),
+          component(graph.numVertices(), -1), inDegree(graph.numVertices()),
+          outDegree(graph.numVertices()), nextColor(1), nextComponent(0) {}
+
+    int colorOf(int v) const { return color[v].load(std::memory_order_relaxed); }
+
+    void recolor(int v, int c) { color[v].store(c, std::memory_order_relaxed); }
+
+    // make `v` a component of its own
+    void finishTrivial(int v)
+    {
+        component[v] = nextComponent.fetch_add(1, std::memory_order_relaxed);
+        recolor(v, DONE);
+    }
+
+    // Remove the trivial SCCs of the part of color `c` whose vertices are
+    // `members`: a vertex with no in-arcs or no out-arcs from its own part
+    // cannot be on a cycle. Removing it lowers the degrees of its
+    // neighbors, which may expose further trivial SCCs.
+    void trim(int c, std::vector<int> const &members)
+    {
+        std::vector<int> worklist;
+
+        for (int v: members)
+        {
+            int out = 0, in = 0;
+            for (int u: graph.neighbors(v)) {
+                out += colorOf(u) == c;
+            }
+            for (int u: reverse.neighbors(v)) {
+                in += colorOf(u) == c;
+            }
+
+            outDegree[v] = out;
+            inDegree[v] = in;
+            if (out == 0 || in == 0) {
+                worklist.push_back(v);
+            }
+        }
+
+        while (!worklist.empty())
+        {
+            int v = worklist.back();
+            worklist.pop_back();
+
+            if (colorOf(v) != c) {
+                continue;
+            }
+            finishTrivial(v);
+
+            for (int u: graph.neighbors(v))
+            {
+                if (colorOf(u) == c && --inDegree[u] == 0) {
+                    worklist.push_back(u);
+                }
+            }
+            for (int u: reverse.neighbors(v))
+            {
+                if (colorOf(u) == c && --outDegree[u] == 0) {
+                    worklist.push_back(u);
+                }
+            }
+        }
+    }
+
+    // Split the part of color `c` with a sequential forward-backward search
+    // from `pivot`: the SCC of the pivot is finished, and the vertices only
+    // reached forward or only reached backward get the colors `forward` and
+    // `backward`
+    void splitSequential(int c, int pivot, int forward, int backward)
+    {
+        int scc = nextComponent.fetch_add(1, std::memory_order_relaxed);
+        std::vector<int> queue(1, pivot);
+
+        // forward: everything of color `c` reachable from the pivot
+        recolor(pivot, forward);
+        for (std::size_t i = 0; i < queue.size(); i++)
+        {
+            for (int u: graph.neighbors(queue[i]))
+            {
+                if (colorOf(u) == c)
+                {
+                    recolor(u, forward);
+                    queue.push_back(u);
+                }
+            }
+        }
+
+        // backward: reached vertices that are also forward form the SCC
+        queue.assign(1, pivot);
+        component[pivot] = scc;
+        recolor(pivot, DONE);
+
+        for (std::size_t i = 0; i < queue.size(); i++)
+        {
+            for (int u: reverse.neighbors(queue[i]))
+            {
+                int cu = colorOf(u);
+                if (cu == forward)
+                {
+                    component[u] = scc;
+                    recolor(u, DONE);
+                    queue.push_back(u);
+                }
+                else if (cu == c)
+                {
+                    recolor(u, backward);
+                    queue.push_back(u);
+                }
+            }
+        }
+    }
+};
+
+}
+
+template <typename Graph>
+SCCResult parallelStronglyConnectedComponents(Graph const &graph, Graph const &reverse,
+        ThreadPool &pool)
+{
+    using namespace parallel_scc_detail;
+
+    int n = graph.numVertices();
+    unsigned threads = pool.size();
+    State<Graph> state(graph, reverse);
+
+    // phase 1a: trim vertices without in-arcs or out-arcs, all in color 0.
+    // Each chunk reserves its component ids with a single atomic add.
+    pool.parallelFor(n, 4096, [&](unsigned, std::size_t begin, std::size_t end)
+    {
+        int trivial = 0;
+        for (std::size_t v = begin; v < end; v++)
+        {
+            bool isTrivial = graph.degree(v) == 0 || reverse.degree(v) == 0;
+            state.recolor(v, isTrivial ? DONE : 0);
+            trivial += isTrivial;
+        }
+
+        int id = state.nextComponent.fetch_add(trivial, std::memory_order_relaxed);
+        for (std::size_t v = begin; v < end; v++)
+        {
+            if (state.colorOf(v) == DONE) {
+                state.component[v] = id++;
+            }
+        }
+    });
+
+    // phase 1b: pick the remaining vertex with the largest in-degree ×
+    // out-degree, which most likely belongs to the giant SCC
+    std::vector<std::size_t> bestScore(threads, 0);
+    std::vector<int> bestVertex(threads, -1);
+
+    pool.parallelFor(n, 4096, [&](unsigned t, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t v = begin; v < end; v++)
+        {
+            std::size_t score = graph.degree(v) * reverse.degree(v);
+            if (state.colorOf(v) == 0 && (bestVertex[t] == -1 || score > bestScore[t]))
+            {
+                bestScore[t] = score;
+                bestVertex[t] = v;
+            }
+        }
+    });
+
+    int pivot = -1;
+    std::size_t pivotScore = 0;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        if (bestVertex[t] != -1 && (pivot == -1 || bestScore[t] > pivotScore))
+        {
+            pivot = bestVertex[t];
+            pivotScore = bestScore[t];
+        }
+    }
+
+    std::deque<Task> tasks;
+
+    if (pivot != -1)
+    {
+        // phase 1c: parallel forward-backward search from the pivot. Vertices
+        // are claimed with a compare-and-swap on their color.
+        int forward = state.nextColor++;
+        int inScc = state.nextColor++;
+        int backward = state.nextColor++;
+
+        std::vector<std::vector<int>> local(threads);
+        std::vector<std::size_t> position(threads + 1);
+
+        auto search = [&](Graph const &g, int claimed, int from1, int to1, int from2, int to2)
+        {
+            std::vector<int> frontier(1, pivot), next;
+            state.recolor(pivot, claimed);
+
+            while (!frontier.empty())
+            {
+                pool.parallelFor(frontier.size(), 256,
+                        [&](unsigned t, std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        for (int u: g.neighbors(frontier[i]))
+                        {
+                            int cu = state.colorOf(u);
+                            if ((cu == from1 && state.color[u].compare_exchange_strong(cu, to1,
+                                    std::memory_order_relaxed)) ||
+                                (cu == from2 && state.color[u].compare_exchange_strong(cu, to2,
+                                    std::memory_order_relaxed))) {
+                                local[t].push_back(u);
+                            }
+                        }
+                    }
+                });
+
+                position[0] = 0;
+                for (unsigned t = 0; t < threads; t++) {
+                    position[t + 1] = position[t] + local[t].size();
+                }
+
+                next.resize(position[threads]);
+                pool.run([&](unsigned t)
+                {
+                    std::copy(local[t].begin(), local[t].end(), next.begin() + position[t]);
+                    local[t].clear();
+                });
+
+                frontier.swap(next);
+            }
+        };
+
+        // forward: color 0 → forward; backward: forward → SCC, 0 → backward
+        search(graph, forward, 0, forward, -2, -2);
+        search(reverse, inScc, forward, inScc, 0, backward);
+
+        // collect the three remaining parts, finish the giant SCC
+        int giant = state.nextComponent++;
+        std::vector<std::vector<int>> parts(3 * threads);
+
+        pool.parallelFor(n, 4096, [&](unsigned t, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t v = begin; v < end; v++)
+            {
+                int c = state.colorOf(v);
+                if (c == inScc)
+                {
+                    state.component[v] = giant;
+                    state.recolor(v, DONE);
+                }
+                else if (c == forward) {
+                    parts[3 * t].push_back(v);
+                }
+                else if (c == backward) {
+                    parts[3 * t + 1].push_back(v);
+                }
+                else if (c == 0) {
+                    parts[3 * t + 2].push_back(v);
+                }
+            }
+        });
+
+        int colors[3] = { forward, backward, 0 };
+        for (int p = 0; p < 3; p++)
+        {
+            Task task = { colors[p], std::vector<int>() };
+            for (unsigned t = 0; t < threads; t++)
+            {
+                std::vector<int> const &part = parts[3 * t + p];
+                task.members.insert(task.members.end(), part.begin(), part.end());
+            }
+            if (!task.members.empty()) {
+                tasks.push_back(std::move(task));
+            }
+        }
+    }
+
+    // phase 2: the remaining parts are independent tasks
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::size_t unfinished = tasks.size();
+
+    pool.run([&](unsigned)
+    {
+        for (;;)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return !tasks.empty() || unfinished == 0; });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            int c = task.color;
+            state.trim(c, task.members);
+
+            std::vector<int> rest;
+            for (int v: task.members)
+            {
+                if (state.colorOf(v) == c) {
+                    rest.push_back(v);
+                }
+            }
+
+            std::vector<Task> pieces;
+            if (!rest.empty())
+            {
+                int forward = state.nextColor++;
+                int backward = state.nextColor++;
+                state.splitSequential(c, rest[0], forward, backward);
+
+                Task parts[3] = { { forward, {} }, { backward, {} }, { c, {} } };
+                for (int v: rest)
+                {
+                    int cv = state.colorOf(v);
+                    if (cv == forward) {
+                        parts[0].members.push_back(v);
+                    }
+                    else if (cv == backward) {
+                        parts[1].members.push_back(v);
+                    }
+                    else if (cv == c) {
+                        parts[2].members.push_back(v);
+                    }
+                }
+
+                for (Task &part: parts)
+                {
+                    if (!part.members.empty()) {
+                        pieces.push_back(std::move(part));
+                    }
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (Task &piece: pieces) {
+                    tasks.push_back(std::move(piece));
+                }
+                unfinished += pieces.size();
+                unfinished--;
+            }
+            changed.notify_all();
+        }
+    });
+
+    SCCResult result;
+    result.count = state.nextComponent.load();
+    result.size.assign(result.count, 0);
+    for (int v = 0; v < n; v++) {
+        result.size[state.component[v]]++;
+    }
+    result.component.swap(state.component);
+
+    return result;
+}
+
+#endif
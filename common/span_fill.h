@@ -0,0 +1,100 @@
+#ifndef SPAN_FILL_H
+#define SPAN_FILL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "grid.h"
+
+// Scanline (span) flood fill.
+//
+// Instead of one queue entry per pixel, the fill works on horizontal runs:
+// from a pixel of the target color it extends left and right to the whole
+// run, recolors it in one pass, and records the run as a span. Popping a
+// span scans the rows above and below it, over the same columns (one more
+// on each side for 8-connectivity, which also reaches diagonally), and
+// every run of the target color met there is filled and recorded in turn.
+// A run is recolored as it is recorded, so it can never be recorded twice:
+// the work is linear in the number of pixels filled plus the number of runs,
+// and the pending spans, on an explicit stack instead of the call stack,
+// never outnumber the runs of the region.
+
+// Fill the region of pixel (x, y), rows given by `rowAt(i)` as a pointer to
+// `cols` pixels; return the number of pixels recolored
+template <typename T, typename RowAt>
+std::size_t spanFillRows(RowAt rowAt, int rows, int cols, int x, int y, T replacement,
+        GridConnectivity connectivity)
+{
+    T const target = rowAt(x)[y];
+    if (target == replacement) {
+        return 0;
+    }
+
+    int reach = connectivity == EightConnected ? 1 : 0;
+
+    // a filled run: columns [left, right) of row `row`
+    struct Span
+    {
+        int row, left, right;
+    };
+    std::vector<Span> pending;
+    std::size_t filled = 0;
+
+    // fill the run of the target color through column `j` of row `i` and
+    // return the column just past it
+    auto fillRun = [&](T *pixels, int i, int j)
+    {
+        int left = j, right = j + 1;
+        while (left > 0 && pixels[left - 1] == target) {
+            left--;
+        }
+        while (right < cols && pixels[right] == target) {
+            right++;
+        }
+
+        std::fill(pixels + left, pixels + right, replacement);
+        filled += right - left;
+        pending.push_back({ i, left, right });
+        return right;
+    };
+
+    fillRun(rowAt(x), x, y);
+
+    while (!pending.empty())
+    {
+        Span span = pending.back();
+        pending.pop_back();
+
+        for (int i = span.row - 1; i <= span.row + 1; i += 2)
+        {
+            if (i < 0 || i >= rows) {
+                continue;
+            }
+
+            T *pixels = rowAt(i);
+            int end = std::min(cols, span.right + reach);
+            for (int j = std::max(0, span.left - reach); j < end; j++)
+            {
+                if (pixels[j] == target) {
+                    j = fillRun(pixels, i, j);
+                }
+            }
+        }
+    }
+
+    return filled;
+}
+
+// Replace the color of pixel (x, y) of `grid`, and of every pixel connected
+// to it through pixels of the same color, by `replacement`
+template <typename T>
+std::size_t spanFill(Grid<T> &grid, int x, int y, T replacement, GridConnectivity connectivity)
+{
+    if (grid.rows() == 0) {
+        return 0;
+    }
+    return spanFillRows([&](int i) { return &grid(i, 0); }, grid.rows(), grid.cols(),
+            x, y, replacement, connectivity);
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef STREAMING_ISLANDS_H
+#define STREAMING_ISLANDS_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bit_grid.h"
+#include "island_labeling.h"
+#include "union_find.h"
+
+// Island counting over a raster streamed one row at a time.
+//
+// Only the runs of the previous row are kept, each tagged with the open
+// island (component) it belongs to. For every new row, a union-find over the
+// open islands plus the runs of the new row merges each run with the
+// touching runs above, exactly as `labelIslandRuns` does, and the
+// union-find is then thrown away. An open island that no run of the new row
+// touches can never grow again, so it is reported right away through the
+// `onIsland` callback with its size and bounding box.
+//
+// A row has at most `cols / 2 + 1` runs, so everything kept between rows is
+// O(cols): the raster can be any number of rows long, read from a file or a
+// pipe, and is never held in memory.
+
+// What is known about an island once it is complete
+struct IslandSummary
+{
+    // number of land cells
+    long long cells = 0;
+
+    // bounding box, rows and columns inclusive
+    int top = INT_MAX, bottom = INT_MIN, left = INT_MAX, right = INT_MIN;
+
+    void merge(IslandSummary const &other)
+    {
+        cells += other.cells;
+        top = std::min(top, other.top);
+        bottom = std::max(bottom, other.bottom);
+        left = std::min(left, other.left);
+        right = std::max(right, other.right);
+    }
+};
+
+class StreamingIslandCounter
+{
+public:
+    typedef std::function<void(IslandSummary const &)> Callback;
+
+    // `onIsland`, if given, is called once for every complete island
+    StreamingIslandCounter(int cols, GridConnectivity connectivity, Callback onIsland = nullptr)
+        : width(cols), reach(connectivity == EightConnected ? 1 : 0),
+          onIsland(std::move(onIsland)) {}
+
+    int cols() const { return width; }
+
+    // number of rows added so far
+    int rows() const { return row; }
+
+    // number of islands completed so far; after `finish()`, all of them
+    std::size_t count() const { return islands; }
+
+    // Add the next row, packed as in `BitGrid::row()`: `bitsetWords(cols)`
+    // words with the bits past the last column set to 0
+    void addRow(std::uint64_t const *bits)
+    {
+        current.clear();
+        forEachRun(bits, width, [&](int begin, int end) {
+            current.push_back({ begin, end, -1 });
+        });
+
+        // elements 0 .. k - 1 are the open islands, k + r is run `r`
+        int k = open.size();
+        sets.reset(k + current.size());
+
+        std::size_t above = 0;
+        for (std::size_t r = 0; r < current.size(); r++)
+        {
+            while (above < previous.size() && previous[above].end + reach <= current[r].begin) {
+                above++;
+            }
+            for (std::size_t a = above;
+                    a < previous.size() && previous[a].begin < current[r].end + reach; a++) {
+                sets.unite(previous[a].island, k + r);
+            }
+        }
+
+        // every set holding a run of this row becomes an open island of the
+        // next round, numbered in the order of its first run
+        renumber.assign(k + current.size(), -1);
+        next.clear();
+
+        for (std::size_t r = 0; r < current.size(); r++)
+        {
+            int root = sets.find(k + r);
+            if (renumber[root] == -1)
+            {
+                renumber[root] = next.size();
+                next.push_back(IslandSummary());
+            }
+            current[r].island = renumber[root];
+
+            IslandSummary run;
+            run.cells = current[r].end - current[r].begin;
+            run.top = run.bottom = row;
+            run.left = current[r].begin;
+            run.right = current[r].end - 1;
+            next[current[r].island].merge(run);
+        }
+
+        // open islands are only ever joined through a run of this row, so
+        // one left out of every such set is alone and complete
+        for (int c = 0; c < k; c++)
+        {
+            int root = sets.find(c);
+            if (renumber[root] == -1) {
+                complete(open[c]);
+            }
+            else {
+                next[renumber[root]].merge(open[c]);
+            }
+        }
+
+        open.swap(next);
+        previous.swap(current);
+        row++;
+    }
+
+    // add a row given as a `vector` of 0 (water) and nonzero (land) cells
+    template <typename T>
+    void addRow(std::vector<T> const &cells)
+    {
+        packed.assign(bitsetWords(width), 0);
+        for (int j = 0; j < width; j++)
+        {
+            if (cells[j]) {
+                packed[j >> 6] |= std::uint64_t(1) << (j & 63);
+            }
+        }
+        addRow(packed.data());
+    }
+
+    // the raster has ended: every island still open is complete
+    void finish()
+    {
+        for (IslandSummary const &island: open) {
+            complete(island);
+        }
+        open.clear();
+        previous.clear();
+    }
+
+private:
+    struct OpenRun
+    {
+        int begin, end, island;
+    };
+
+    int width, reach;
+    Callback onIsland;
+
+    int row = 0;
+    std::size_t islands = 0;
+
+    // runs of the last row added and of the row being added
+    std::vector<OpenRun> previous, current;
+
+    // islands touching the last row added, and their next version
+    std::vector<IslandSummary> open, next;
+
+    UnionFind sets;
+    std::vector<int> renumber;
+    std::vector<std::uint64_t> packed;
+
+    void complete(IslandSummary const &island)
+    {
+        islands++;
+        if (onIsland) {
+            onIsland(island);
+        }
+    }
+};
+
+// Count the islands of a text raster read line by line from `in`: one row
+// per line, '1' for land and '0' for water, other whitespace ignored. All
+// lines must have the same number of cells. Only the current line and the
+// counter's O(cols) state are in memory at any time.
+inline std::size_t countIslandsStreaming(std::istream &in, GridConnectivity connectivity,
+        StreamingIslandCounter::Callback onIsland = nullptr)
+{
+    std::string line;
+    std::vector<std::uint64_t> packed;
+    std::optional<StreamingIslandCounter> counter;
+
+    while (std::getline(in, line))
+    {
+        packed.assign(bitsetWords(line.size()), 0);
+
+        int cols = 0;
+        for (char c: line)
+        {
+            if (c == '1') {
+                packed[cols >> 6] |= std::uint64_t(1) << (cols & 63);
+            }
+            else if (c != '0')
+            {
+                if (c == ' ' || c == '\t' || c == '\r') {
+                    continue;
+                }
+                throw std::runtime_error("unexpected character in raster row "
+                        + std::to_string(counter ? counter->rows() + 1 : 1));
+            }
+            cols++;
+        }
+
+        // the first row fixes the width
+        if (!counter) {
+            counter.emplace(cols, connectivity, onIsland);
+        }
+        else if (cols != counter->cols()) {
+            throw std::runtime_error("raster row " + std::to_string(counter->rows() + 1)
+                    + " has " + std::to_string(cols) + " cells, expected "
+                    + std::to_string(counter->cols()));
+        }
+
+        counter->addRow(packed.data());
+    }
+
+    if (!counter) {
+        return 0;
+    }
+    counter->finish();
+    return counter->count();
+}
+
+// Count the islands (connected groups of 1 cells) of a bit-packed raster by
+// the same two-row sweep: O(cols) memory besides the raster, where
+// `labelIslandRuns` keeps an entry per run of the whole raster
+inline std::size_t countIslands(BitGrid const &grid, GridConnectivity connectivity)
+{
+    StreamingIslandCounter counter(grid.cols(), connectivity);
+    for (int i = 0; i < grid.rows(); i++) {
+        counter.addRow(grid.row(i));
+    }
+    counter.finish();
+    return counter.count();
+}
+
+#endif
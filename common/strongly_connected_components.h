@@ -0,0 +1,204 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_H
+#define STRONGLY_CONNECTED_COMPONENTS_H
+
+#include <cstddef>
+#include <vector>
+#include "dense_bitset.h"
+
+// Strongly connected components with Pearce's space-efficient variant of
+// Tarjan's algorithm.
+//
+// Tarjan's algorithm keeps an arrival time, a low-link value and an
+// on-stack flag per vertex. Pearce's variant folds all three into a single
+// `rindex` array plus one "is root" bit: a vertex whose component is done
+// gets a component number counting down from n - 1, which is larger than
+// any arrival time still in use, so the on-stack test becomes a comparison.
+// The DFS is driven by an explicit stack of (vertex, next arc) frames
+// instead of recursion, so arbitrarily deep graphs (long chains, for
+// example) do not overflow the call stack. The whole run takes O(V + E)
+// time and one int plus one bit per vertex besides the two stacks.
+//
+// `Graph` is any graph type offering `numVertices()` and `neighbors(v)`,
+// such as `CSRGraph`.
+
+struct SCCResult
+{
+    // `component[v]` is the id of the component holding vertex `v`, from 0
+    // to `count - 1`. `stronglyConnectedComponents()` assigns the ids in the
+    // order the components are completed, which is a reverse topological
+    // order of the condensation: every arc `u → v` between two components
+    // has `component[u] > component[v]`.
+    std::vector<int> component;
+
+    // `size[c]` is the number of vertices in component `c`
+    std::vector<int> size;
+
+    // total number of components
+    int count = 0;
+};
+
+template <typename Graph>
+SCCResult stronglyConnectedComponents(Graph const &graph)
+{
+    typedef decltype(graph.neighbors(0).begin()) ArcIterator;
+
+    // one frame of the simulated recursion: a vertex and its next unscanned
+    // arc; the end of the arcs is looked up again instead of being stored
+    struct Frame
+    {
+        int v;
+        ArcIterator next;
+    };
+
+    int n = graph.numVertices();
+
+    // 0 for unvisited vertices, the arrival time (from 1) while a vertex is
+    // being explored, and its component number (counting down from n - 1)
+    // once its component is complete. While the vertex is on the stack it
+    // holds the smallest arrival time it can reach, like Tarjan's low-link.
+    std::vector<int> rindex(n, 0);
+
+    // `root[v]` is cleared once `v` is known to reach an earlier vertex
+    DenseBitset root(n);
+
+    // explored vertices whose component is not complete yet
+    std::vector<int> pending;
+    std::vector<Frame> stack;
+
+    int index = 1;
+    int c = n - 1;
+
+    for (int start = 0; start < n; start++)
+    {
+        if (rindex[start] != 0) {
+            continue;
+        }
+
+        auto enter = [&](int v)
+        {
+            root.set(v);
+            rindex[v] = index++;
+            stack.push_back({ v, graph.neighbors(v).begin() });
+        };
+
+        enter(start);
+
+        while (!stack.empty())
+        {
+            Frame &frame = stack.back();
+            int v = frame.v;
+
+            if (frame.next != graph.neighbors(v).end())
+            {
+                int w = *frame.next;
+                ++frame.next;
+
+                if (rindex[w] == 0)
+                {
+                    // tree edge: descend into `w`, the update of `v` happens
+                    // when `w` returns
+                    enter(w);
+                    continue;
+                }
+
+                if (rindex[w] < rindex[v])
+                {
+                    rindex[v] = rindex[w];
+                    root.reset(v);
+                }
+                continue;
+            }
+
+            // all arcs of `v` are scanned; return from `v`
+            stack.pop_back();
+
+            if (root.test(v))
+            {
+                // `v` closes a component made of `v` and every pending
+                // vertex explored after it
+                index--;
+                while (!pending.empty() && rindex[v] <= rindex[pending.back()])
+                {
+                    int w = pending.back();
+                    pending.pop_back();
+                    rindex[w] = c;
+                    index--;
+                }
+                rindex[v] = c;
+                c--;
+            }
+            else {
+                pending.push_back(v);
+            }
+
+            if (!stack.empty())
+            {
+                int parent = stack.back().v;
+                if (rindex[v] < rindex[parent])
+                {
+                    rindex[parent] = rindex[v];
+                    root.reset(parent);
+                }
+            }
+        }
+    }
+
+    // renumber the components from 0 in the order they were completed;
+    // `rindex` becomes the label array, so no second array is allocated
+    SCCResult result;
+    result.count = n - 1 - c;
+    result.size.assign(result.count, 0);
+
+    for (int v = 0; v < n; v++)
+    {
+        rindex[v] = n - 1 - rindex[v];
+        result.size[rindex[v]]++;
+    }
+
+    result.component.swap(rindex);
+    return result;
+}
+
+// Count the arcs of the condensation, i.e., the distinct pairs of different
+// components `(c, d)` such that some arc goes from `c` to `d`
+template <typename Graph>
+std::size_t countCondensationArcs(Graph const &graph, SCCResult const &scc)
+{
+    int n = graph.numVertices();
+
+    // group the vertices by component with a counting sort
+    std::vector<int> start(scc.count + 1, 0), members(n);
+    for (int c = 0; c < scc.count; c++) {
+        start[c + 1] = start[c] + scc.size[c];
+    }
+
+    std::vector<int> next(start.begin(), start.end() - 1);
+    for (int v = 0; v < n; v++) {
+        members[next[scc.component[v]]++] = v;
+    }
+
+    // `seenFrom[d] == c` once the arc (c, d) has been counted
+    std::vector<int> seenFrom(scc.count, -1);
+    std::size_t arcs = 0;
+
+    for (int c = 0; c < scc.count; c++)
+    {
+        seenFrom[c] = c;
+        for (int i = start[c]; i < start[c + 1]; i++)
+        {
+            for (int u: graph.neighbors(members[i]))
+            {
+                int d = scc.component[u];
+                if (seenFrom[d] != c)
+                {
+                    seenFrom[d] = c;
+                    arcs++;
+                }
+            }
+        }
+    }
+
+    return arcs;
+}
+
+#endif
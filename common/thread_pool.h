@@ -0,0 +1,129 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that run one task at a time on all threads.
+//
+// Level-synchronous algorithms issue many short parallel steps (one per BFS
+// level, for example), so the workers are created once and kept waiting for
+// the next task instead of being spawned for every step. The calling thread
+// takes part in every task as thread 0.
+class ThreadPool
+{
+public:
+    // `threads` is the total number of threads including the caller;
+    // 0 means one per hardware thread
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (unsigned id = 1; id < threads; id++) {
+            workers.emplace_back([this, id] { workerLoop(id); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    // total number of threads, including the caller
+    unsigned size() const { return workers.size() + 1; }
+
+    // Run `task(threadId)` once on every thread, with `threadId` ranging over
+    // [0, size()), and return when all of them have finished
+    void run(std::function<void(unsigned)> const &task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &task;
+            pending = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+    // Split [0, n) into chunks of `grain` indices handed out dynamically,
+    // and call `body(threadId, begin, end)` for every chunk
+    template <typename Body>
+    void parallelFor(std::size_t n, std::size_t grain, Body const &body)
+    {
+        std::atomic<std::size_t> next(0);
+        grain = std::max<std::size_t>(grain, 1);
+
+        run([&](unsigned threadId)
+        {
+            for (;;)
+            {
+                std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= n) {
+                    break;
+                }
+                body(threadId, begin, std::min(n, begin + grain));
+            }
+        });
+    }
+
+private:
+    void workerLoop(unsigned id)
+    {
+        std::size_t seen = 0;
+        for (;;)
+        {
+            std::function<void(unsigned)> const *task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                task = current;
+            }
+
+            (*task)(id);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    std::function<void(unsigned)> const *current = nullptr;
+    std::size_t pending = 0;
+    std::size_t generation = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef TRANSITIVE_CLOSURE_H
+#define TRANSITIVE_CLOSURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "strongly_connected_components.h"
+
+// Transitive closure of a directed graph, computed on its condensation.
+//
+// All vertices of a strongly connected component reach exactly the same
+// vertices, so the closure only needs one row per component. The components
+// are visited in reverse topological order, so when a component is reached
+// every component it has an arc to is already done, and its row is the OR
+// of theirs. Rows are packed 64 components per word in one flat matrix, which
+// takes one bit per pair of components, and a reachability query is a single
+// word lookup.
+class TransitiveClosure
+{
+public:
+    // `Graph` is any graph type offering `numVertices()` and `neighbors(v)`
+    template <typename Graph>
+    explicit TransitiveClosure(Graph const &graph)
+    {
+        SCCResult scc = stronglyConnectedComponents(graph);
+        component = scc.component;
+
+        int n = graph.numVertices();
+        int count = scc.count;
+        wordsPerRow = (count + 63) / 64;
+        matrix.assign(std::size_t(count) * wordsPerRow, 0);
+
+        // group the vertices by component with a counting sort
+        std::vector<int> start(count + 1, 0), members(n);
+        for (int v = 0; v < n; v++) {
+            start[component[v] + 1]++;
+        }
+        for (int c = 0; c < count; c++) {
+            start[c + 1] += start[c];
+        }
+
+        std::vector<int> next(start.begin(), start.end() - 1);
+        for (int v = 0; v < n; v++) {
+            members[next[component[v]]++] = v;
+        }
+
+        // component ids already are a reverse topological order: every arc
+        // leaving component `c` goes to a component with a smaller id
+        for (int c = 0; c < count; c++)
+        {
+            std::uint64_t *row = rowOf(c);
+            setBit(row, c);
+
+            for (int i = start[c]; i < start[c + 1]; i++)
+            {
+                for (int u: graph.neighbors(members[i]))
+                {
+                    int d = component[u];
+
+                    // if `d` is already in the row, so is everything `d`
+                    // reaches, because rows are closed under reachability
+                    if (!testBit(row, d))
+                    {
+                        std::uint64_t const *successor = rowOf(d);
+                        for (std::size_t w = 0; w < wordsPerRow; w++) {
+                            row[w] |= successor[w];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Is there a directed path from `u` to `v`? (every vertex reaches itself)
+    bool reachable(int u, int v) const
+    {
+        return testBit(rowOf(component[u]), component[v]);
+    }
+
+    // number of strongly connected components, i.e., rows of the matrix
+    int numComponents() const { return matrix.empty() ? 0 : matrix.size() / wordsPerRow; }
+
+    // component of vertex `v`
+    int componentOf(int v) const { return component[v]; }
+
+private:
+    std::uint64_t *rowOf(int c) { return matrix.data() + std::size_t(c) * wordsPerRow; }
+
+    std::uint64_t const *rowOf(int c) const
+    {
+        return matrix.data() + std::size_t(c) * wordsPerRow;
+    }
+
+    static bool testBit(std::uint64_t const *row, int c) { return (row[c >> 6] >> (c & 63)) & 1; }
+
+    static void setBit(std::uint64_t *row, int c) { row[c >> 6] |= std::uint64_t(1) << (c & 63); }
+
+    std::vector<int> component;
+    std::size_t wordsPerRow = 0;
+    std::vector<std::uint64_t> matrix;
+};
+
+#endif
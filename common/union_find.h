@@ -0,0 +1,163 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Disjoint sets over the elements 0 .. n - 1 (union-find), sequential and
+// concurrent.
+//
+// `find` halves the path it walks (every visited element is pointed to its
+// grandparent), and `unite` always hangs the larger root below the smaller
+// one, so the root of every set is its smallest element. Labeling code
+// relies on that: the first element of a component in scan order is its
+// representative. Linking by index instead of by rank or size keeps that
+// property but gives up the inverse-Ackermann bound: with path halving alone
+// an operation takes O(log n) amortized time (Tarjan and van Leeuwen).
+//
+// Elements are 64-bit: labeling by runs puts one element per run of a whole
+// raster in one union-find, and a noisy 100k × 100k mask has billions of
+// runs, past the range of `int`.
+class UnionFind
+{
+public:
+    explicit UnionFind(std::size_t n = 0): parent(n)
+    {
+        for (std::size_t i = 0; i < n; i++) {
+            parent[i] = i;
+        }
+    }
+
+    // number of elements
+    std::size_t size() const { return parent.size(); }
+
+    // start over with `n` elements in sets of their own, reusing the storage
+    void reset(std::size_t n)
+    {
+        parent.resize(n);
+        for (std::size_t i = 0; i < n; i++) {
+            parent[i] = i;
+        }
+    }
+
+    // add a new element in a set of its own and return it
+    std::int64_t add()
+    {
+        parent.push_back(parent.size());
+        return parent.size() - 1;
+    }
+
+    // representative (smallest element) of the set holding `x`
+    std::int64_t find(std::int64_t x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // merge the sets holding `x` and `y`; return false if they were
+    // already the same set
+    bool unite(std::int64_t x, std::int64_t y)
+    {
+        x = find(x);
+        y = find(y);
+        if (x == y) {
+            return false;
+        }
+
+        if (x < y) {
+            parent[y] = x;
+        }
+        else {
+            parent[x] = y;
+        }
+        return true;
+    }
+
+    // whether `x` is the representative of its set
+    bool isRoot(std::int64_t x) const { return parent[x] == x; }
+
+private:
+    std::vector<std::int64_t> parent;
+};
+
+// Union-find that several threads may update at once (after Anderson and
+// Woll). Roots are linked with a compare-and-swap of the larger root's
+// parent from itself to the smaller root; if another thread linked it first
+// the CAS fails and the union is retried from the new roots. Linking always
+// points to a smaller index, so there can be no cycle, and as in
+// `UnionFind` the root of a set is its smallest element. Path halving in
+// `find` is a plain relaxed store: it only ever replaces a parent by an
+// ancestor, which any thread may do in any order.
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(std::size_t n = 0): parent(n)
+    {
+        for (std::size_t i = 0; i < n; i++) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t size() const { return parent.size(); }
+
+    // set the parent of `x` before any concurrent use, e.g., to load the
+    // result of a sequential `UnionFind`; `p` must not exceed `x`
+    void initialize(std::int64_t x, std::int64_t p)
+    {
+        parent[x].store(p, std::memory_order_relaxed);
+    }
+
+    std::int64_t find(std::int64_t x)
+    {
+        std::int64_t p = parent[x].load(std::memory_order_relaxed);
+        while (p != x)
+        {
+            std::int64_t grandparent = parent[p].load(std::memory_order_relaxed);
+            if (grandparent != p) {
+                parent[x].store(grandparent, std::memory_order_relaxed);
+            }
+            x = p;
+            p = grandparent;
+        }
+        return x;
+    }
+
+    bool unite(std::int64_t x, std::int64_t y)
+    {
+        for (;;)
+        {
+            x = find(x);
+            y = find(y);
+            if (x == y) {
+                return false;
+            }
+            if (x < y) {
+                std::swap(x, y);
+            }
+
+            // `x` is the larger root; hang it below `y` unless it stopped
+            // being a root in the meantime
+            std::int64_t expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    bool isRoot(std::int64_t x) const
+    {
+        return parent[x].load(std::memory_order_relaxed) == x;
+    }
+
+private:
+    std::vector<std::atomic<std::int64_t>> parent;
+};
+
+#endif
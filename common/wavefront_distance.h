@@ -0,0 +1,150 @@
+#ifndef WAVEFRONT_DISTANCE_H
+#define WAVEFRONT_DISTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bit_grid.h"
+
+// Multi-source BFS distances on a grid (4-connected moves), computed a
+// whole level at a time on bit rows.
+//
+// The frontier of the current level and the cells not reached yet are
+// packed one bit per cell, as in `BitGrid`. The next level is
+//
+//   (frontier shifted left | right | up | down) & unreached
+//
+// computed 64 cells per word operation; a left or right shift carries the
+// edge bit over from the neighboring word. Only the rows next to a nonempty
+// frontier row are looked at, so a level costs O(words in those rows), and
+// the distance of a cell is written once, when its bit first appears in a
+// new frontier. The word loops are plain shifts, ANDs and ORs over
+// contiguous arrays, which compilers turn into SIMD code on their own.
+//
+// With many sources the levels are few and wide, which is where this wins
+// over a cell-by-cell queue; on a long winding corridor every level holds a
+// handful of cells and a scalar BFS is just as good.
+
+// Distance of every cell from the nearest cell of `sources`, moving between
+// 4-adjacent cells of `open`, as a row-major array: `distance[i × cols + j]`.
+// Sources are at distance 0 (whether open or not), and cells that are not
+// open or cannot be reached get -1.
+inline std::vector<int> wavefrontDistances(BitGrid const &open, BitGrid const &sources)
+{
+    int rows = open.rows(), cols = open.cols();
+    std::size_t words = open.wordsPerRow();
+
+    std::vector<int> distance(std::size_t(rows) * cols, -1);
+    std::vector<std::uint64_t> frontier(rows * words, 0), next(rows * words, 0);
+    std::vector<std::uint64_t> unreached(rows * words);
+
+    // rows whose frontier is not empty, and a per-row stamp of the level in
+    // which the row was last scheduled, to schedule each row once per level
+    std::vector<int> active, scheduled, reached;
+    std::vector<int> stamp(rows, -1);
+
+    for (int i = 0; i < rows; i++)
+    {
+        std::uint64_t const *o = open.row(i), *s = sources.row(i);
+        bool any = false;
+
+        for (std::size_t w = 0; w < words; w++)
+        {
+            frontier[i * words + w] = s[w];
+            unreached[i * words + w] = o[w] & ~s[w];
+            any |= s[w] != 0;
+        }
+        if (any) {
+            active.push_back(i);
+        }
+    }
+
+    // write the level into the cells of bit row `bits` of row `i`
+    auto writeLevel = [&](int i, std::uint64_t const *bits, int level)
+    {
+        int *d = &distance[std::size_t(i) * cols];
+        for (std::size_t w = 0; w < words; w++)
+        {
+            for (std::uint64_t word = bits[w]; word; word &= word - 1) {
+                d[(w << 6) + __builtin_ctzll(word)] = level;
+            }
+        }
+    };
+
+    // level 0: the sources
+    for (int i: active) {
+        writeLevel(i, sources.row(i), 0);
+    }
+
+    for (int level = 1; !active.empty(); level++)
+    {
+        // a row can only gain cells if it or a row next to it is active
+        scheduled.clear();
+        for (int i: active)
+        {
+            for (int r = i - 1; r <= i + 1; r++)
+            {
+                if (r >= 0 && r < rows && stamp[r] != level)
+                {
+                    stamp[r] = level;
+                    scheduled.push_back(r);
+                }
+            }
+        }
+
+        reached.clear();
+        for (int i: scheduled)
+        {
+            std::uint64_t const *f = &frontier[i * words];
+            std::uint64_t const *up = i > 0 ? &frontier[(i - 1) * words] : nullptr;
+            std::uint64_t const *down = i + 1 < rows ? &frontier[(i + 1) * words] : nullptr;
+            std::uint64_t *u = &unreached[i * words];
+            std::uint64_t *n = &next[i * words];
+
+            std::uint64_t any = 0;
+            for (std::size_t w = 0; w < words; w++)
+            {
+                // neighbors to the left and right, with the bit crossing the
+                // word boundary carried over
+                std::uint64_t spread = f[w] | (f[w] << 1) | (f[w] >> 1);
+                if (w > 0) {
+                    spread |= f[w - 1] >> 63;
+                }
+                if (w + 1 < words) {
+                    spread |= f[w + 1] << 63;
+                }
+                if (up) {
+                    spread |= up[w];
+                }
+                if (down) {
+                    spread |= down[w];
+                }
+
+                n[w] = spread & u[w];
+                u[w] &= ~n[w];
+                any |= n[w];
+            }
+
+            if (any)
+            {
+                reached.push_back(i);
+                writeLevel(i, n, level);
+            }
+        }
+
+        // the new level becomes the frontier; only the rows that were active
+        // hold bits, so only they need clearing
+        for (int i: active)
+        {
+            for (std::size_t w = 0; w < words; w++) {
+                frontier[i * words + w] = 0;
+            }
+        }
+        frontier.swap(next);
+        active.swap(reached);
+    }
+
+    return distance;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <random>
+#include "../common/csr_graph.h"
+#include "../common/direction_optimizing_bfs.h"
+using namespace std;
+
+// Data structure to store a graph edge
+struct Edge {
+    int src, dest;
+};
+
+// Plain top-down BFS used to cross-check the distances
+vector<int> referenceBFS(CSRGraph<int> const &graph, int source)
+{
+    vector<int> distance(graph.numVertices(), -1);
+    queue<int> q;
+
+    distance[source] = 0;
+    q.push(source);
+
+    while (!q.empty())
+    {
+        int u = q.front();
+        q.pop();
+
+        for (int v: graph.neighbors(u))
+        {
+            if (distance[v] == -1)
+            {
+                distance[v] = distance[u] + 1;
+                q.push(v);
+            }
+        }
+    }
+
+    return distance;
+}
+
+// Check that every reached vertex other than the source has a parent that
+// is one of its neighbors and lies exactly one level closer to the source
+bool isValidParentArray(CSRGraph<int> const &graph, BFSResult const &result, int source)
+{
+    for (int v = 0; v < graph.numVertices(); v++)
+    {
+        int p = result.parent[v];
+        if (v == source || result.distance[v] == -1)
+        {
+            if (p != -1) {
+                return false;
+            }
+            continue;
+        }
+
+        if (p == -1 || result.distance[p] != result.distance[v] - 1) {
+            return false;
+        }
+
+        bool isNeighbor = false;
+        for (int u: graph.neighbors(p)) {
+            isNeighbor = isNeighbor || u == v;
+        }
+
+        if (!isNeighbor) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Print how every level of the search was expanded
+void printLevels(BFSResult const &result)
+{
+    for (BFSLevel const &level: result.levels)
+    {
+        cout << "Level " << level.depth << ": "
+             << (level.direction == TopDown ? "top-down " : "bottom-up")
+             << ", frontier " << level.frontierSize
+             << ", arcs examined " << level.arcsExamined << endl;
+    }
+}
+
+int main()
+{
+    // vector of graph edges as per the above diagram
+    vector<Edge> edges = {
+        {1, 2}, {1, 3}, {1, 4}, {2, 5}, {2, 6}, {5, 9},
+        {5, 10}, {4, 7}, {4, 8}, {7, 11}, {7, 12}
+        // vertex 0, 13, and 14 are single nodes
+    };
+
+    // total number of nodes in the graph (labelled from 0 to 14)
+    int n = 15;
+
+    // build a graph from the given edges
+    CSRGraph<int> graph(edges, n, Undirected);
+
+    // the graph is undirected, so it is its own transpose
+    BFSResult result = directionOptimizingBFS(graph, graph, 1);
+
+    printLevels(result);
+
+    // print the distance and parent of every vertex
+    cout << endl << "Vertex Distance Parent" << endl;
+    for (int v = 0; v < n; v++)
+    {
+        cout << left << setw(7) << v << setw(9) << result.distance[v]
+             << result.parent[v] << endl;
+    }
+
+    // a larger random graph with a small diameter, where the middle levels
+    // hold most of the vertices
+    int m = 100000;
+    mt19937 rng(42);
+    vector<Edge> randomEdges;
+    for (int i = 0; i < 8 * m; i++) {
+        randomEdges.push_back({ int(rng() % m), int(rng() % m) });
+    }
+
+    CSRGraph<int> randomGraph(randomEdges, m, Undirected);
+    BFSResult randomResult = directionOptimizingBFS(randomGraph, randomGraph, 0);
+
+    cout << endl;
+    printLevels(randomResult);
+
+    cout << endl << "Distances match plain BFS: "
+         << (randomResult.distance == referenceBFS(randomGraph, 0) ? "yes" : "no") << endl;
+    cout << "Parent array is valid: "
+         << (isValidParentArray(randomGraph, randomResult, 0) ? "yes" : "no") << endl;
+
+    return 0;
+}
+
+
+// Output:
+
+// Level 0: bottom-up, frontier 1, arcs examined 15
+// Level 1: bottom-up, frontier 3, arcs examined 8
+// Level 2: bottom-up, frontier 4, arcs examined 4
+// Level 3: bottom-up, frontier 4, arcs examined 0
+//
+// Vertex Distance Parent
+// 0      -1       -1
+// 1      0        -1
+// 2      1        1
+// 3      1        1
+// 4      1        1
+// 5      2        2
+// 6      2        2
+// 7      2        4
+// 8      2        4
+// 9      3        5
+// 10     3        5
+// 11     3        7
+// 12     3        7
+// 13     -1       -1
+// 14     -1       -1
+//
+// Level 0: top-down , frontier 1, arcs examined 20
+// Level 1: top-down , frontier 20, arcs examined 315
+// Level 2: top-down , frontier 295, arcs examined 5041
+// Level 3: top-down , frontier 4618, arcs examined 78110
+// Level 4: bottom-up, frontier 49521, arcs examined 87024
+// Level 5: bottom-up, frontier 45528, arcs examined 17
+// Level 6: top-down , frontier 17, arcs examined 117
+//
+// Distances match plain BFS: yes
+// Parent array is valid: yes
+
+// Each level costs O(V) in bottom-up mode and O(arcs out of the frontier) in top-down mode;
+// the whole search stays O(V + E), but the large middle levels examine only a fraction of their arcs.
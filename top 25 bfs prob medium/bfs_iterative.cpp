@@ -1,6 +1,9 @@
 #include <iostream>
 #include <queue>
 #include <vector>
+#include "../common/compressed_graph.h"
+#include "../common/csr_graph.h"
+#include "../common/dense_bitset.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -9,35 +12,24 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Graph Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the undirected graph
-        for (auto &edge: edges)
-        {
-            adjList[edge.src].push_back(edge.dest);
-            adjList[edge.dest].push_back(edge.src);
-        }
-    }
+    // stores the undirected graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Undirected) {}
 };
  
-// Perform BFS on the graph starting from vertex `v`
-void BFS(Graph const &graph, int v, vector<bool> &discovered)
+// Perform BFS on the graph starting from vertex `v`; `Graph` may be the
+// CSR graph above or a `CompressedGraph`, whose neighbors are decoded on the fly
+template <typename Graph>
+void BFS(Graph const &graph, int v, DenseBitset &discovered)
 {
     // create a queue for doing BFS
     queue<int> q;
  
     // mark the source vertex as discovered
-    discovered[v] = true;
+    discovered.set(v);
  
     // enqueue source vertex
     q.push(v);
@@ -51,12 +43,11 @@ void BFS(Graph const &graph, int v, vector<bool> &discovered)
         cout << v << " ";
  
         // do for every edge (v, u)
-        for (int u: graph.adjList[v])
+        for (int u: graph.neighbors(v))
         {
-            if (!discovered[u])
-            {
-                // mark it as discovered and enqueue it
-                discovered[u] = true;
+            // mark it as discovered and enqueue it, unless it
+            // was discovered before
+            if (!discovered.testAndSet(u)) {
                 q.push(u);
             }
         }
@@ -79,18 +70,32 @@ int main()
     Graph graph(edges, n);
  
     // to keep track of whether a vertex is discovered or not
-    vector<bool> discovered(n, false);
+    DenseBitset discovered(n);
  
     // Perform BFS traversal from all undiscovered nodes to
-    // cover all connected components of a graph
-    for (int i = 0; i < n; i++)
+    // cover all connected components of a graph; `findNextUnset` skips
+    // over 64 discovered vertices at a time
+    for (int i = discovered.findNextUnset(0); i < n; i = discovered.findNextUnset(i + 1))
     {
-        if (discovered[i] == false)
-        {
-            // start BFS traversal from vertex `i`
-            BFS(graph, i, discovered);
-        }
+        // start BFS traversal from vertex `i`
+        BFS(graph, i, discovered);
+    }
+    cout << endl;
+ 
+    // the same traversal over gap-encoded neighbor lists; the neighbors
+    // of every vertex above are already in increasing order, so the
+    // visiting order does not change
+    CompressedGraph compressed(graph);
+    discovered.clear();
+ 
+    for (int i = discovered.findNextUnset(0); i < n; i = discovered.findNextUnset(i + 1)) {
+        BFS(compressed, i, discovered);
     }
+    cout << endl;
+ 
+    cout << "CSR graph: " << graph.offsets.size() * sizeof(size_t) +
+            graph.targets.size() * sizeof(int) << " bytes, compressed: " <<
+            compressed.memoryBytes() << " bytes" << endl;
  
     return 0;
 }
@@ -99,4 +104,5 @@ int main()
 // Output:
 
 // 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14
-
+// 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14
+// CSR graph: 216 bytes, compressed: 105 bytes
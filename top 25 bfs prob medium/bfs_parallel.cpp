@@ -0,0 +1,128 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <random>
+#include "../common/csr_graph.h"
+#include "../common/parallel_csr_builder.h"
+#include "../common/parallel_bfs.h"
+using namespace std;
+
+// Data structure to store a graph edge
+struct Edge {
+    int src, dest;
+};
+
+// Sequential BFS used to cross-check the distances
+vector<int> sequentialBFS(CSRGraph<int> const &graph, int source)
+{
+    vector<int> distance(graph.numVertices(), -1);
+    queue<int> q;
+
+    distance[source] = 0;
+    q.push(source);
+
+    while (!q.empty())
+    {
+        int u = q.front();
+        q.pop();
+
+        for (int v: graph.neighbors(u))
+        {
+            if (distance[v] == -1)
+            {
+                distance[v] = distance[u] + 1;
+                q.push(v);
+            }
+        }
+    }
+
+    return distance;
+}
+
+int main()
+{
+    // vector of graph edges as per the above diagram
+    vector<Edge> edges = {
+        {1, 2}, {1, 3}, {1, 4}, {2, 5}, {2, 6}, {5, 9},
+        {5, 10}, {4, 7}, {4, 8}, {7, 11}, {7, 12}
+        // vertex 0, 13, and 14 are single nodes
+    };
+
+    // total number of nodes in the graph (labelled from 0 to 14)
+    int n = 15;
+
+    // build a graph from the given edges
+    CSRGraph<int> graph(edges, n, Undirected);
+
+    // one thread per hardware thread
+    ThreadPool pool;
+
+    BFSResult result = parallelBFS(graph, 1, pool);
+
+    // print the distance and parent of every vertex
+    cout << "Vertex Distance Parent" << endl;
+    for (int v = 0; v < n; v++)
+    {
+        cout << left << setw(7) << v << setw(9) << result.distance[v]
+             << result.parent[v] << endl;
+    }
+
+    // a larger random graph, checked against the sequential BFS
+    int m = 1000000;
+    mt19937 rng(42);
+    vector<Edge> randomEdges;
+    for (int i = 0; i < 8 * m; i++) {
+        randomEdges.push_back({ int(rng() % m), int(rng() % m) });
+    }
+
+    // built on all threads as well: degrees, offsets and arc placement
+    CSRGraph<int> randomGraph = buildCSRGraphParallel(randomEdges, m, Undirected, pool);
+    BFSResult randomResult = parallelBFS(randomGraph, 0, pool);
+
+    cout << endl;
+    for (BFSLevel const &level: randomResult.levels)
+    {
+        cout << "Level " << level.depth << ": frontier " << level.frontierSize
+             << ", arcs examined " << level.arcsExamined << endl;
+    }
+
+    cout << endl << "Distances match sequential BFS: "
+         << (randomResult.distance == sequentialBFS(randomGraph, 0) ? "yes" : "no") << endl;
+
+    return 0;
+}
+
+
+// Output:
+
+// Vertex Distance Parent
+// 0      -1       -1
+// 1      0        -1
+// 2      1        1
+// 3      1        1
+// 4      1        1
+// 5      2        2
+// 6      2        2
+// 7      2        4
+// 8      2        4
+// 9      3        5
+// 10     3        5
+// 11     3        7
+// 12     3        7
+// 13     -1       -1
+// 14     -1       -1
+//
+// Level 0: frontier 1, arcs examined 19
+// Level 1: frontier 19, arcs examined 296
+// Level 2: frontier 277, arcs examined 4698
+// Level 3: frontier 4415, arcs examined 74892
+// Level 4: frontier 67807, arcs examined 1150047
+// Level 5: frontier 613866, arcs examined 10116730
+// Level 6: frontier 313599, arcs examined 4653233
+// Level 7: frontier 16, arcs examined 85
+//
+// Distances match sequential BFS: yes
+
+// The total work is O(V + E) as in the sequential BFS, spread over the threads of the pool;
+// every level ends with a barrier, so the speedup grows with the size of the frontiers.
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <queue>
 #include <vector>
+#include "../common/csr_graph.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -9,25 +10,12 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Graph Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the undirected graph
-        for (auto &edge: edges)
-        {
-            adjList[edge.src].push_back(edge.dest);
-            adjList[edge.dest].push_back(edge.src);
-        }
-    }
+    // stores the undirected graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Undirected) {}
 };
  
 // Perform BFS recursively on the graph
@@ -43,7 +31,7 @@ void recursiveBFS(Graph const &graph, queue<int> &q, vector<bool> &discovered)
     cout << v << " ";
  
     // do for every edge (v, u)
-    for (int u: graph.adjList[v])
+    for (int u: graph.neighbors(v))
     {
         if (!discovered[u])
         {
@@ -1,7 +1,8 @@
 #include <iostream>
-#include <set>
-#include <queue>
+#include <vector>
 #include <climits>
+#include "../common/bidirectional_bfs.h"
+#include "../common/knight_distance.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements
@@ -15,77 +16,48 @@ bool isValid(int x, int y, int N) {
     return (x >= 0 && x < N) && (y >= 0 && y < N);
 }
  
-// A queue node used in BFS
+// A square of the chessboard
 struct Node
 {
     // (x, y) represents chessboard coordinates
-    // `dist` represents its minimum distance from the source
-    int x, y, dist;
- 
-    // Node constructor
-    Node(int x, int y, int dist = 0): x(x), y(y), dist(dist) {}
- 
-    // As we are using struct as a key in a `std::set`,
-    // we need to overload `<` operator`.
-    // Alternatively, we can use `std::pair<int, int>` as a key
-    // to store the matrix coordinates in the set.
- 
-    bool operator<(const Node& o) const {
-        return x < o.x || (x == o.x && y < o.y);
-    }
+    int x, y;
 };
  
-// Find the minimum number of steps taken by the knight
-// from the source to reach the destination using BFS
+// Find the minimum number of steps taken by the knight from the source to
+// reach the destination, in O(1): from the closed form on boards of 5 × 5
+// and more, from a table of at most 256 entries on smaller ones. The BFS
+// in `main` only checks it.
 int findShortestDistance(int N, Node src, Node dest)
 {
-    // set to check if the matrix cell is visited before or not
-    set<Node> visited;
+    int steps = KnightDistance(N)(src.x, src.y, dest.x, dest.y);
  
-    // create a queue and enqueue the first node
-    queue<Node> q;
-    q.push(src);
+    // return infinity if the path is not possible
+    return steps == -1 ? INT_MAX : steps;
+}
  
-    // loop till queue is empty
-    while (!q.empty())
+// Same as `findShortestDistance`, but searching from the source and from the
+// destination at once, until the two searches meet. Square (x, y) is vertex
+// `x × N + y`; knight moves are symmetric, so both searches use them.
+// `search` holds two 12-byte entries per square, so this is for boards of up
+// to 46340 × 46340, whose squares an `int` can number (and which already
+// take 48 GB); larger ones are answered by `KnightDistance` without any
+// search.
+int findShortestDistanceBidirectional(BidirectionalBFS &search, int N, Node src, Node dest)
+{
+    auto moves = [&](int square, auto &&visit)
     {
-        // dequeue front node and process it
-        Node node = q.front();
-        q.pop();
- 
-        int x = node.x;
-        int y = node.y;
-        int dist = node.dist;
- 
-        // if the destination is reached, return distance
-        if (x == dest.x && y == dest.y) {
-            return dist;
-        }
- 
-        // skip if the location is visited before
-        if (!visited.count(node))
+        int x = square / N, y = square % N;
+        for (int i = 0; i < 8; i++)
         {
-            // mark the current node as visited
-            visited.insert(node);
- 
-            // check for all eight possible movements for a knight
-            // and enqueue each valid movement
-            for (int i = 0; i < 8; i++)
-            {
-                // get the knight's valid position from the current position on
-                // the chessboard and enqueue it with +1 distance
-                int x1 = x + row[i];
-                int y1 = y + col[i];
- 
-                if (isValid(x1, y1, N)) {
-                    q.push({x1, y1, dist + 1});
-                }
+            if (isValid(x + row[i], y + col[i], N)) {
+                visit((x + row[i]) * N + y + col[i]);
             }
         }
-    }
+    };
  
-    // return infinity if the path is not possible
-    return INT_MAX;
+    int dist = search.find(src.x * N + src.y, dest.x * N + dest.y, moves, moves).length;
+ 
+    return dist == -1 ? INT_MAX : dist;
 }
  
 int main()
@@ -100,7 +72,40 @@ int main()
     Node dest = {7, 0};
  
     cout << "The minimum number of steps required is " <<
-            findShortestDistance(N, src, dest);
+            findShortestDistance(N, src, dest) << endl;
+ 
+    BidirectionalBFS search(N * N);
+    cout << "With a bidirectional search: " <<
+            findShortestDistanceBidirectional(search, N, src, dest) << endl;
+ 
+    // the same by a BFS over the whole board, as a check
+    vector<int> dist = knightDistancesFrom(N, src.x, src.y);
+    cout << "By BFS over the board: " << dist[dest.x * N + dest.y] << endl;
+ 
+    // check the closed form against BFS for every pair of squares of the
+    // boards up to 16 × 16, small irregular boards included
+    bool agree = true;
+    for (int n = 1; n <= 16; n++)
+    {
+        KnightDistance distance(n);
+        for (int x = 0; x < n; x++)
+        {
+            for (int y = 0; y < n; y++)
+            {
+                vector<int> dist = knightDistancesFrom(n, x, y);
+                for (int i = 0; i < n * n; i++) {
+                    agree &= dist[i] == distance(x, y, i / n, i % n);
+                }
+            }
+        }
+    }
+    cout << "Closed form agrees with BFS on all boards up to 16 x 16: "
+         << (agree ? "yes" : "no") << endl;
+ 
+    // a board far too large to search
+    KnightDistance huge(1000000);
+    cout << "Corner to corner on a 1000000 x 1000000 board: "
+         << huge(0, 0, 999999, 999999) << endl;
  
     return 0;
 }
@@ -108,5 +113,13 @@ int main()
 // Output:
 
 // The minimum number of steps required is 6
-// The time complexity of the proposed solution is O(M × N) and 
-// requires O(M × N) extra space, where M and N are dimensions of the matrix.
\ No newline at end of file
+// With a bidirectional search: 6
+// By BFS over the board: 6
+// Closed form agrees with BFS on all boards up to 16 x 16: yes
+// Corner to corner on a 1000000 x 1000000 board: 666666
+// The proposed solution takes O(1) time and space per query on boards of
+// 5 × 5 and more; the BFS that checks it takes O(N²) time and space.
+// The bidirectional search visits about b^(d/2) squares from each end instead
+// of b^d from the source, for b = 8 moves and a distance of d steps.
+// `KnightDistance` answers a query in O(1) time on boards of 5 × 5 and more,
+// and keeps an O(N^4) table, at most 256 entries, only for smaller boards.
\ No newline at end of file
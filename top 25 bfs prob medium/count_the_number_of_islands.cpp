@@ -1,7 +1,13 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <string>
 #include <cstring>
+#include "../common/dense_bitset.h"
+#include "../common/grid.h"
+#include "../common/island_labeling.h"
+#include "../common/parallel_island_labeling.h"
+#include "../common/streaming_islands.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements from a cell
@@ -9,74 +15,59 @@ using namespace std;
 int row[] = { -1, -1, -1, 0, 1, 0, 1, 1 };
 int col[] = { -1, 1, 0, -1, -1, 1, 0, 1 };
  
-// Function to check if it is safe to go to position (x, y)
-// from the current position. The function returns false if (x, y)
-// is not valid matrix coordinates or (x, y) represents water or
-// position (x, y) is already processed
+// The map is a `Grid` whose border ring holds 0 (water), so every one of the
+// eight movements from a matrix cell stays inside the grid and no bounds
+// check is needed. Cell processing is tracked with one bit per grid index.
  
-bool isSafe(vector<vector<int>> const &mat, int x, int y,
-        vector<vector<bool>> const &processed)
+void BFS(Grid<int> const &mat, DenseBitset &processed, size_t cell)
 {
-    return (x >= 0 && x < mat.size()) && (y >= 0 && y < mat[0].size()) &&
-        mat[x][y] && !processed[x][y];
-}
+    // the eight movements as constant offsets in the grid
+    auto moves = mat.neighborOffsets(row, col);
  
-void BFS(vector<vector<int>> const &mat, vector<vector<bool>> &processed, int i, int j)
-{
     // create an empty queue and enqueue source node
-    queue<pair<int, int>> q;
-    q.push(make_pair(i, j));
+    queue<size_t> q;
+    q.push(cell);
  
     // mark source node as processed
-    processed[i][j] = true;
+    processed.set(cell);
  
     // loop till queue is empty
     while (!q.empty())
     {
         // dequeue front node and process it
-        int x = q.front().first;
-        int y = q.front().second;
+        cell = q.front();
         q.pop();
  
         // check for all eight possible movements from the current cell
         // and enqueue each valid movement
-        for (int k = 0; k < 8; k++)
+        for (ptrdiff_t move: moves)
         {
-            // skip if the location is invalid, or already
-            // processed, or consists of water
-            if (isSafe(mat, x + row[k], y + col[k], processed))
-            {
-                // mark it as processed and enqueue it
-                processed[x + row[k]][y + col[k]] = 1;
-                q.push(make_pair(x + row[k], y + col[k]));
+            // skip if the location consists of water (as the border
+            // does), or is already processed; otherwise mark it as
+            // processed and enqueue it
+            size_t next = cell + move;
+            if (mat[next] && !processed.testAndSet(next)) {
+                q.push(next);
             }
         }
     }
 }
  
-int countIslands(vector<vector<int>> const &mat)
+int countIslands(Grid<int> const &mat)
 {
-    // base case
-    if (mat.size() == 0) {
-        return 0;
-    }
- 
-    // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
- 
-    // stores if a cell is processed or not
-    vector<vector<bool>> processed(M, vector<bool>(N));
+    // stores if a cell is processed or not, one bit per grid index
+    DenseBitset processed(mat.size());
  
     int island = 0;
-    for (int i = 0; i < M; i++)
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < N; j++)
+        // cells of a row are consecutive in the grid
+        for (size_t cell = mat.index(i, 0); cell < mat.index(i, 0) + mat.cols(); cell++)
         {
             // start BFS from each unprocessed node and increment island count
-            if (mat[i][j] && processed[i][j] == 0)
+            if (mat[cell] && !processed.test(cell))
             {
-                BFS(mat, processed, i, j);
+                BFS(mat, processed, cell);
                 island++;
             }
         }
@@ -101,7 +92,36 @@ int main()
         { 1, 1, 1, 1, 0, 0, 0, 1, 1, 1 }
     };
  
-    cout << "The total number of islands is " << countIslands(mat) << endl;
+    // store the matrix in a flat grid surrounded by water
+    Grid<int> grid(mat, 0);
+ 
+    cout << "The total number of islands is " << countIslands(grid) << endl;
+ 
+    // the same count on a one-bit-per-cell raster, finding runs of land
+    // 64 cells at a time and merging touching runs of adjacent rows, with
+    // only two rows of runs kept at any time
+    BitGrid land(mat);
+ 
+    cout << "The total number of islands is " << countIslands(land, EightConnected)
+         << " (bit-packed), " << countIslands(land, FourConnected)
+         << " without diagonal moves" << endl;
+ 
+    // label the raster on all threads, in bands of rows stitched together
+    // with a concurrent union-find, and print the island of every cell
+    ThreadPool pool;
+    IslandLabels labels = parallelLabelIslandRuns(land, EightConnected, pool);
+    vector<int64_t> island = islandLabelMap(labels, land.rows(), land.cols(), pool);
+ 
+    cout << "The total number of islands is " << labels.count << " (parallel)" << endl;
+    for (int i = 0; i < land.rows(); i++)
+    {
+        for (int j = 0; j < land.cols(); j++)
+        {
+            int64_t label = island[i * land.cols() + j];
+            cout << (label == -1 ? string(" .") : " " + to_string(label));
+        }
+        cout << endl;
+    }
  
     return 0;
 }
@@ -111,6 +131,21 @@ int main()
 // Output:
 
 // The total number of islands is 5
+// The total number of islands is 5 (bit-packed), 9 without diagonal moves
+// The total number of islands is 5 (parallel)
+//  0 . 1 . . . 2 2 2 2
+//  . . 1 . 1 . 2 . . .
+//  1 1 1 1 . . 2 . . .
+//  1 . . 1 . 2 . . . .
+//  1 1 1 1 . . . 3 3 3
+//  . 1 . 1 . . 3 3 3 3
+//  . . . . . 3 3 3 . .
+//  . . . 4 . . 3 3 3 .
+//  4 . 4 . 4 . . 3 . .
+//  4 4 4 4 . . . 3 3 3
 
 // The time complexity of the proposed solution is O(M × N) and 
-// requires O(M × N) extra space, where M and N are dimensions of the matrix.
\ No newline at end of file
+// requires O(M × N) extra space, where M and N are dimensions of the matrix.
+// The bit-packed count takes O(M × N / 64 + R) time and O(N) extra space,
+// where R is the number of runs of consecutive land cells in the rows; the
+// labeling takes the same time and O(R) extra space.
\ No newline at end of file
@@ -1,31 +1,26 @@
 #include <iostream>
 #include <algorithm>
 #include <queue>
+#include "../common/grid.h"
 using namespace std;
  
-// Data structure to store the cell coordinates of the matrix
-struct Point {
-    int x, y;
-};
- 
-// Function to check whether given coordinates is a valid cell or not
-bool isValid(int i, int j, vector<vector<int>> &mat) {
-    return (i >= 0 && i < mat.size()) && (j >= 0 && j < mat[0].size());
-}
- 
 // Below arrays detail all four possible movements from a cell
 // (top, right, bottom, and left)
 int row[] = { -1, 0, 0, 1 };
 int col[] = { 0, -1, 1, 0 };
  
+// The matrix is a `Grid` whose border ring holds 0, which is neither
+// negative nor positive, so a cell beyond the edge is never converted and
+// the four movements need no bounds check.
+ 
 // Returns true if the matrix contains at least one negative value
-bool hasNegative(vector<vector<int>> &mat)
+bool hasNegative(Grid<int> const &mat)
 {
-    for (int i = 0; i < mat.size(); i++)
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < mat[0].size(); j++)
+        for (int j = 0; j < mat.cols(); j++)
         {
-            if (mat[i][j] < 0) {
+            if (mat(i, j) < 0) {
                 return true;
             }
         }
@@ -35,23 +30,26 @@ bool hasNegative(vector<vector<int>> &mat)
  
 // Find the minimum number of passes required to convert all negative values
 // in the given matrix to positive
-int findMinPasses(vector<vector<int>> &mat)
+int findMinPasses(Grid<int> &mat)
 {
     // base case
-    if (mat.size() == 0) {
+    if (mat.rows() == 0) {
         return 0;
     }
  
-    // create a queue to store cell coordinates of positive integers
-    queue<Point> Q;
+    // the four movements as constant offsets in the grid
+    auto moves = mat.neighborOffsets(row, col);
+ 
+    // create a queue to store the grid index of positive integers
+    queue<size_t> Q;
  
-    // enqueue cell coordinates of all positive numbers in the matrix
-    for (int i = 0; i < mat.size(); i++)
+    // enqueue all positive numbers in the matrix
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < mat[0].size(); j++)
+        for (int j = 0; j < mat.cols(); j++)
         {
-            if (mat[i][j] > 0) {
-                Q.push({i, j});
+            if (mat(i, j) > 0) {
+                Q.push(mat.index(i, j));
             }
         }
     }
@@ -64,7 +62,7 @@ int findMinPasses(vector<vector<int>> &mat)
     {
         // use two queues to separate positive numbers involved in the
         // previous pass with positive numbers involved in the current pass
-        queue<Point> q;
+        queue<size_t> q;
  
         // copy contents of the original queue `Q` to another queue `q` and
         // empty the original queue
@@ -76,22 +74,22 @@ int findMinPasses(vector<vector<int>> &mat)
         while (!q.empty())
         {
             // pop front node and process it
-            int x = q.front().x;
-            int y = q.front().y;
+            size_t cell = q.front();
             q.pop();
  
             // check all four adjacent cells of the current cell
-            for (int k = 0; k < 4; k++)
+            for (ptrdiff_t move: moves)
             {
-                // if the current adjacent cell is valid and has a negative value
-                if (isValid(x + row[k], y + col[k], mat) &&
-                    mat[x + row[k]][y + col[k]] < 0)
+                // if the adjacent cell has a negative value (border cells
+                // hold 0)
+                size_t next = cell + move;
+                if (mat[next] < 0)
                 {
                     // make the value positive
-                    mat[x + row[k]][y + col[k]] = -mat[x + row[k]][y + col[k]];
+                    mat[next] = -mat[next];
  
                     // enqueue adjacent cell
-                    Q.push({x + row[k], y + col[k]});
+                    Q.push(next);
                 }
             }
         }
@@ -117,7 +115,10 @@ int main()
         { 0, -7, -3, 5, -4 }
     };
  
-    int pass = findMinPasses(mat);
+    // store the matrix in a flat grid with a ring of zeros around it
+    Grid<int> grid(mat, 0);
+ 
+    int pass = findMinPasses(grid);
     if (pass != -1) {
         cout << "The total number of passes required is " << pass;
     }
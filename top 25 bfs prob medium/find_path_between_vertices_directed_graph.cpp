@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include "../common/bidirectional_bfs.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -63,6 +64,45 @@ bool isReachable(Graph const &graph, int src, int dest,
     return false;
 }
  
+// Graph with every edge of `graph` reversed
+Graph reverseGraph(Graph const &graph)
+{
+    vector<Edge> edges;
+    int n = graph.adjList.size();
+    for (int u = 0; u < n; u++)
+    {
+        for (int v: graph.adjList[u]) {
+            edges.push_back({v, u});
+        }
+    }
+    return Graph(edges, n);
+}
+ 
+// Find a shortest path from `src` to `dest` by BFS from both ends: forward
+// along the edges of `graph` and backward along those of `reverse`, until
+// the two searches meet. `search` holds one entry per vertex and may serve
+// any number of queries on the graph.
+bool isReachableBidirectional(Graph const &graph, Graph const &reverse,
+        BidirectionalBFS &search, int src, int dest, vector<int> &path)
+{
+    auto successors = [&](int u, auto &&visit)
+    {
+        for (int v: graph.adjList[u]) {
+            visit(v);
+        }
+    };
+    auto predecessors = [&](int v, auto &&visit)
+    {
+        for (int u: reverse.adjList[v]) {
+            visit(u);
+        }
+    };
+ 
+    BidirectionalPath result = search.find(src, dest, successors, predecessors);
+    path.assign(result.path.begin(), result.path.end());
+    return result.length != -1;
+}
+ 
 // Utility function to print a path
 void printPath(vector<int> const &path)
 {
@@ -106,6 +146,17 @@ int main()
         cout << "No path exists between vertices " << src << " and " << dest;
     }
  
+    // search from both ends over the graph and its reverse
+    Graph reverse = reverseGraph(graph);
+    BidirectionalBFS search(n);
+    vector<int> shortest;
+ 
+    if (isReachableBidirectional(graph, reverse, search, src, dest, shortest))
+    {
+        cout << "A shortest path found from both ends is ";
+        printPath(shortest);
+    }
+ 
     return 0;
 }
 
@@ -114,6 +165,9 @@ int main()
 
 // Path exists from vertex 0 to vertex 7
 // The complete path is 0 3 4 6 7
+// A shortest path found from both ends is 0 3 4 6 7
 
 // The time complexity of the above solutions is O(V + E), 
-// where V and E are the total number of vertices and edges in the graph, respectively.
\ No newline at end of file
+// where V and E are the total number of vertices and edges in the graph, respectively.
+// The bidirectional search is O(V + E) as well, but stops once the two
+// searches meet, typically after far fewer vertices than a one-way search.
\ No newline at end of file
@@ -2,42 +2,35 @@
 #include <vector>
 #include <queue>
 #include <iomanip>
+#include "../common/grid.h"
+#include "../common/bit_grid.h"
+#include "../common/wavefront_distance.h"
 using namespace std;
  
 // A Queue Node
 struct Node
 {
-    int x;          // stores x–coordinate of a matrix cell
-    int y;          // stores y–coordinate of a matrix cell
-    int distance;   // stores the distance of (x, y) from mine
+    size_t cell;    // stores the grid index of a matrix cell
+    int distance;   // stores the distance of the cell from mine
 };
  
-// check if specified row and column are valid matrix index
-bool isValid(int i, int j, int M, int N) {
-    return (i >= 0 && i < M) && (j >= 0 && j < N);
-}
- 
 // check if the current cell is an open area, and its
-// distance from the mine is not yet calculated
-bool isSafe(int i, int j, vector<vector<char>> const &mat,
-        vector<vector<int>> const &result) {
-    return mat[i][j] == 'O' && result[i][j] == -1;
+// distance from the mine is not yet calculated; the border ring of
+// `mat` holds 'X', so cells beyond the edge are never open
+bool isSafe(size_t cell, Grid<char> const &mat, Grid<int> const &result) {
+    return mat[cell] == 'O' && result[cell] == -1;
 }
  
 // Replace all O's in a matrix with their shortest distance
 // from the nearest mine
-vector<vector<int>> updateShortestDistance(vector<vector<char>> const &mat)
+Grid<int> updateShortestDistance(Grid<char> const &mat)
 {
-    // base case
-    if (mat.size() == 0) {
-        return {};
-    }
- 
     // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
+    int M = mat.rows();
+    int N = mat.cols();
  
-    vector<vector<int>> result(M, vector<int>(N));
+    // initialize the mine distance of every cell by -1
+    Grid<int> result(M, N, -1, -1);
  
     // initialize an empty queue
     queue<Node> q;
@@ -48,46 +41,77 @@ vector<vector<int>> updateShortestDistance(vector<vector<char>> const &mat)
         for (int j = 0; j < N; j++)
         {
             // if the current cell represents a mine
-            if (mat[i][j] == 'M')
+            if (mat(i, j) == 'M')
             {
-                q.push({i, j, 0});
+                q.push({mat.index(i, j), 0});
  
                 // update mine distance as 0
-                result[i][j] = 0;
-            }
-            // otherwise, initialize the mine distance by -1
-            else {
-                result[i][j] = -1;
+                result(i, j) = 0;
             }
         }
     }
  
-    // arrays to get indices of four adjacent cells of a given cell
+    // arrays to get indices of four adjacent cells of a given cell,
+    // turned into constant offsets in the grid
     int row[] = { 0, -1, 0, 1 };
     int col[] = { -1, 0, 1, 0 };
+    auto moves = mat.neighborOffsets(row, col);
  
     // do for each node in the queue
     while (!q.empty())
     {
         // process front cell in the queue
-        int x = q.front().x;
-        int y = q.front().y;
+        size_t cell = q.front().cell;
         int distance = q.front().distance;
  
         // dequeue front cell
         q.pop();
  
         // update the four adjacent cells of the front node in the queue
-        for (int i = 0; i < 4; i++)
+        for (ptrdiff_t move: moves)
         {
-            // enqueue adjacent cell if it is valid, unvisited,
+            // enqueue adjacent cell if it is unvisited
             // and has a path through it
-            if (isValid(x + row[i], y + col[i], M, N) &&
-                isSafe(x + row[i], y + col[i], mat, result))
+            if (isSafe(cell + move, mat, result))
             {
-                result[x + row[i]][y + col[i]] = distance + 1;
-                q.push({x + row[i], y + col[i], distance + 1});
+                result[cell + move] = distance + 1;
+                q.push({cell + move, distance + 1});
+            }
+        }
+    }
+ 
+    return result;
+}
+ 
+// Same distances, computed level by level on bit-packed rows: all cells of
+// the next level are found 64 at a time with shifts and masks
+Grid<int> updateShortestDistanceBitParallel(Grid<char> const &mat)
+{
+    int M = mat.rows();
+    int N = mat.cols();
+ 
+    // open cells and mines, one bit per cell
+    BitGrid open(M, N), mines(M, N);
+    for (int i = 0; i < M; i++)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            if (mat(i, j) == 'O') {
+                open.set(i, j);
             }
+            else if (mat(i, j) == 'M') {
+                mines.set(i, j);
+            }
+        }
+    }
+ 
+    vector<int> distance = wavefrontDistances(open, mines);
+ 
+    Grid<int> result(M, N, -1, -1);
+    for (int i = 0; i < M; i++)
+    {
+        for (int j = 0; j < N; j++) {
+            result(i, j) = distance[i * N + j];
         }
     }
  
@@ -95,12 +119,12 @@ vector<vector<int>> updateShortestDistance(vector<vector<char>> const &mat)
 }
  
 // Utility function to print a matrix
-void printMatrix(vector<vector<int>> const &mat)
+void printMatrix(Grid<int> const &mat)
 {
-    for (int i = 0; i < mat.size(); i++)
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < mat[0].size(); j++) {
-            cout << setw(3) << mat[i][j];
+        for (int j = 0; j < mat.cols(); j++) {
+            cout << setw(3) << mat(i, j);
         }
         cout << endl;
     }
@@ -118,9 +142,16 @@ int main()
         {'O', 'X', 'X', 'M', 'O'}
     };
  
-    vector<vector<int>> output = updateShortestDistance(mat);
+    // store the maze in a flat grid with a ring of walls around it
+    Grid<char> maze(mat, 'X');
+ 
+    Grid<int> output = updateShortestDistance(maze);
     printMatrix(output);
  
+    Grid<int> bitParallel = updateShortestDistanceBitParallel(maze);
+    cout << "\nBit-parallel distances match: "
+         << (bitParallel.toMatrix() == output.toMatrix() ? "yes" : "no") << endl;
+ 
     return 0;
 }
 
@@ -134,5 +165,10 @@ int main()
 // 2   1   0   1   2
 // 3  -1  -1   0   1
 
+// Bit-parallel distances match: yes
+
 // The time complexity of the proposed solution is O(M × N) and 
-// requires O(M × N) extra space, where M and N are dimensions of the matrix.
\ No newline at end of file
+// requires O(M × N) extra space, where M and N are dimensions of the matrix.
+// The bit-parallel version does O(M × N / 64) word operations per level,
+// over the rows next to the frontier only, plus O(M × N) to write the
+// distances out.
\ No newline at end of file
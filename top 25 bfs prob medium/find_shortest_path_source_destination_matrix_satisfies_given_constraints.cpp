@@ -1,36 +1,10 @@
 #include <iostream>
 #include <vector>
-#include <set>
-#include <queue>
+#include <algorithm>
+#include <cstdint>
+#include "../common/dense_bitset.h"
 using namespace std;
  
-// A queue node used in BFS
-struct Node
-{
-    // (x, y) represents coordinates of a cell in the matrix
-    int x, y;
- 
-    // `parent` stores the parent node of the current cell.
-    Node* parent;
- 
-    Node(int x, int y, Node* parent) {
-        this->x = x;
-        this->y = y;
-        this->parent = parent;
-    }
- 
-    // As we are using struct as a key in a `std::set`,
-    // we need to overload the below operators
- 
-    bool const operator==(const Node& ob) const {
-        return x == ob.x && y == ob.y;
-    }
- 
-    bool operator<(const Node& ob) const {
-        return x < ob.x || (x == ob.x && y < ob.y);
-    }
-};
- 
 // Below arrays detail all four possible movements from a cell
 int row[] = { -1, 0, 0, 1 };
 int col[] = { 0, -1, 1, 0 };
@@ -40,88 +14,203 @@ bool isValid(int x, int y, int N) {
     return (x >= 0 && x < N) && (y >= 0 && y < N);
 }
  
-// Function to print the complete path from source to destination
-void findPath(Node* node, vector<pair<int,int>> &path)
+// BFS engine for one `N × N` matrix, reused for any number of sources.
+//
+// Cell (i, j) is the index `i × N + j`. A cell enters the queue at most
+// once, so all the storage a search can need is allocated up front: the
+// queue is one array of N² indices, which doubles as the record of the
+// cells a search has visited, the visited set is one bit per cell, and the
+// parent of every cell is an `int32_t` index instead of a pointer to a heap
+// node. Memory is O(N²) whatever the jumps, and nothing is allocated per
+// search except the path returned. After a search, only the cells it
+// visited are cleared, so a batch of short searches does not pay O(N²)
+// each.
+class JumpPathFinder
 {
-    if (node != nullptr) {
-        findPath(node->parent, path);
-        path.push_back(make_pair(node->x, node->y));
-    }
-}
+public:
+    explicit JumpPathFinder(vector<vector<int>> const &matrix)
+        : matrix(matrix), N(matrix.size()), visited(size_t(N) * N),
+          parent(size_t(N) * N), queue(size_t(N) * N) {}
  
-// Find the shortest route in a matrix from source cell (x, y) to
-// destination cell (N-1, N-1)
-vector<pair<int,int>> findPath(vector<vector<int>> const &matrix, int x, int y)
-{
-    // vector to store the shortest path
-    vector<pair<int,int>> path;
+    // Find the shortest route from source cell (x, y) to destination cell
+    // (N-1, N-1); empty if there is none
+    vector<pair<int,int>> findPath(int x, int y)
+    {
+        // vector to store the shortest path
+        vector<pair<int,int>> path;
  
-    // `N × N` matrix
-    int N = matrix.size();
+        // base case
+        if (N == 0) {
+            return path;
+        }
+ 
+        int32_t target = N * N - 1;
+        int32_t source = x * N + y;
+ 
+        // enqueue the source and mark it as visited
+        size_t head = 0, tail = 0;
+        visited.set(source);
+        parent[source] = -1;
+        queue[tail++] = source;
+ 
+        bool found = false;
+ 
+        // loop till queue is empty
+        while (head < tail)
+        {
+            // dequeue front cell and process it
+            int32_t cell = queue[head++];
+            if (cell == target)
+            {
+                found = true;
+                break;
+            }
+ 
+            int i = cell / N;
+            int j = cell % N;
+ 
+            // get the value of the current cell
+            int n = matrix[i][j];
+ 
+            // check all four possible movements from the current cell
+            for (int k = 0; k < 4; k++)
+            {
+                // get next position coordinates using the value of the current cell
+                int x1 = i + row[k] * n;
+                int y1 = j + col[k] * n;
+ 
+                // enqueue it if it is inside the matrix and not visited yet
+                if (isValid(x1, y1, N))
+                {
+                    int32_t next = x1 * N + y1;
+                    if (!visited.testAndSet(next))
+                    {
+                        parent[next] = cell;
+                        queue[tail++] = next;
+                    }
+                }
+            }
+        }
+ 
+        // follow the parents back from the destination
+        if (found)
+        {
+            for (int32_t cell = target; cell != -1; cell = parent[cell]) {
+                path.push_back(make_pair(cell / N, cell % N));
+            }
+            reverse(path.begin(), path.end());
+        }
+ 
+        // every visited cell is in the queue; clear them for the next search
+        for (size_t k = 0; k < tail; k++) {
+            visited.reset(queue[k]);
+        }
  
-    // base case
-    if (N == 0) {
         return path;
     }
  
-    // create a queue and enqueue the first node
-    queue<Node*> q;
-    Node* src = new Node(x, y, nullptr);
-    q.push(src);
+    // Shortest routes from each of `sources` to (N-1, N-1). The destination
+    // is the same for all of them, so instead of a search per source, one
+    // BFS from the destination over the reversed jumps finds the next cell
+    // on a shortest route from every cell, in O(N²) for the whole batch, and
+    // each route is read off those links.
+    vector<vector<pair<int,int>>> findPaths(vector<pair<int,int>> const &sources)
+    {
+        vector<vector<pair<int,int>>> paths(sources.size());
+        if (N == 0) {
+            return paths;
+        }
+ 
+        int32_t cells = N * N;
  
-    // set to check if the matrix cell is visited before or not
-    set<Node*> visited;
-    visited.insert(src);
+        // the reversed jumps, grouped by landing cell: the cells that jump
+        // onto cell `v` are from[first[v]] .. from[first[v + 1] - 1]
+        vector<int32_t> first(cells + 1, 0);
+        forEachJump([&](int32_t, int32_t v) { first[v + 1]++; });
+        for (int32_t v = 0; v < cells; v++) {
+            first[v + 1] += first[v];
+        }
  
-    // loop till queue is empty
-    while (!q.empty())
-    {
-        // dequeue front node and process it
-        Node* curr = q.front();
-        q.pop();
+        vector<int32_t> from(first[cells]);
+        vector<int32_t> next(first.begin(), first.end() - 1);
+        forEachJump([&](int32_t u, int32_t v) { from[next[v]++] = u; });
  
-        int i = curr->x;
-        int j = curr->y;
+        // BFS from the destination; the parent of a cell is now the cell it
+        // jumps to next on its way to the destination
+        int32_t target = cells - 1;
+        size_t head = 0, tail = 0;
+        visited.set(target);
+        parent[target] = -1;
+        queue[tail++] = target;
  
-        // if the destination is found, print the shortest path and
-        // return the shortest path length
-        if (i == N - 1 && j == N - 1)
+        while (head < tail)
         {
-            findPath(curr, path);
-            return path;
+            int32_t cell = queue[head++];
+            for (int32_t k = first[cell]; k < first[cell + 1]; k++)
+            {
+                if (!visited.testAndSet(from[k]))
+                {
+                    parent[from[k]] = cell;
+                    queue[tail++] = from[k];
+                }
+            }
         }
  
-        // get the value of the current cell
-        int n = matrix[i][j];
- 
-        // check all four possible movements from the current cell
-        // and recur for each valid movement
-        for (int k = 0; k < 4; k++)
+        for (size_t s = 0; s < sources.size(); s++)
         {
-            // get next position coordinates using the value of the current cell
-            int x = i + row[k] * n;
-            int y = j + col[k] * n;
+            int32_t cell = sources[s].first * N + sources[s].second;
+            if (!visited.test(cell)) {
+                continue;
+            }
+            for (; cell != -1; cell = parent[cell]) {
+                paths[s].push_back(make_pair(cell / N, cell % N));
+            }
+        }
  
-            // check if it is possible to go to the next position
-            // from the current position
-            if (isValid(x, y, N))
-            {
-                // construct the next cell node
-                Node* next = new Node(x, y, curr);
+        // clear the visited cells for the next search
+        for (size_t k = 0; k < tail; k++) {
+            visited.reset(queue[k]);
+        }
  
-                // if it isn't visited yet
-                if (!visited.count(next))
+        return paths;
+    }
+ 
+private:
+    vector<vector<int>> const &matrix;
+    int N;
+ 
+    DenseBitset visited;
+    vector<int32_t> parent;
+    vector<int32_t> queue;
+ 
+    // call `visit(u, v)` for every jump from cell `u` to a cell `v` inside
+    // the matrix
+    template <typename Visit>
+    void forEachJump(Visit const &visit) const
+    {
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                int n = matrix[i][j];
+                for (int k = 0; k < 4; k++)
                 {
-                    // enqueue it and mark it as visited
-                    q.push(next);
-                    visited.insert(next);
+                    int x1 = i + row[k] * n;
+                    int y1 = j + col[k] * n;
+                    if (isValid(x1, y1, N)) {
+                        visit(i * N + j, x1 * N + y1);
+                    }
                 }
             }
         }
     }
+};
  
-    // we reach here if the path is not possible
-    return path;
+// Find the shortest route in a matrix from source cell (x, y) to
+// destination cell (N-1, N-1)
+vector<pair<int,int>> findPath(vector<vector<int>> const &matrix, int x, int y)
+{
+    return JumpPathFinder(matrix).findPath(x, y);
 }
  
 template <typename T>
@@ -162,6 +251,23 @@ int main()
     else {
         cout << "Destination not possible";
     }
+    cout << endl;
+ 
+    // a batch of searches from several sources over the same matrix
+    vector<pair<int,int>> sources = { {0, 0}, {2, 3}, {9, 0}, {5, 5} };
+    JumpPathFinder finder(matrix);
+    vector<vector<pair<int,int>>> paths = finder.findPaths(sources);
+ 
+    for (size_t k = 0; k < sources.size(); k++)
+    {
+        cout << "From (" << sources[k].first << ", " << sources[k].second << "): ";
+        if (paths[k].size() > 0) {
+            cout << paths[k].size() - 1 << " moves" << endl;
+        }
+        else {
+            cout << "destination not possible" << endl;
+        }
+    }
  
     return 0;
 }
@@ -169,4 +275,13 @@ int main()
 
 // Output:
 
-// The shortest path is (0, 0) (0, 4) (5, 4) (5, 2) (5, 7) (5, 9) (9, 9)
\ No newline at end of file
+// The shortest path is (0, 0), (0, 4), (5, 4), (5, 2), (5, 7), (5, 9), (9, 9)
+// From (0, 0): 6 moves
+// From (2, 3): 5 moves
+// From (9, 0): 7 moves
+// From (5, 5): 6 moves
+
+// The time complexity of the proposed solution is O(N²) per search, and
+// the searches share O(N²) extra space: a bit, a parent index and a queue
+// slot per cell. A batch of sources takes O(N²) in all, plus the length of
+// the routes returned, with O(N²) more space for the reversed jumps.
\ No newline at end of file
@@ -2,13 +2,16 @@
 #include <climits>
 #include <queue>
 #include <cstring>
+#include "../common/dense_bitset.h"
+#include "../common/grid.h"
 using namespace std;
  
 // A queue node used in BFS
 struct Node {
-    // (x, y) represents a position inside the field
+    // `cell` is the grid index of a position inside the field
     // `dist` represents its minimum distance from the source
-    int x, y, dist;
+    size_t cell;
+    int dist;
 };
  
 // Below arrays detail all four possible movements from a cell,
@@ -16,31 +19,30 @@ struct Node {
 int row[] = { -1, 0, 0, 1 };
 int col[] = { 0, -1, 1, 0 };
  
-// Function to check if it is safe to go to position (x, y)
-// from the current position. The function returns false if (x, y)
-// is unsafe or already visited.
-bool isSafe(vector<vector<int>> const &field, vector<vector<bool>> const &visited,
-                int x, int y) {
-    return field[x][y] != 0 && !visited[x][y];
-}
+// The field is a `Grid` whose border ring holds 0, the value of an unsafe
+// cell, so the border is never entered and never taken for a sensor's
+// neighbor, and no movement needs a bounds check.
  
-// Check if (x, y) is valid field coordinates.
-// Note that we cannot go out of the field.
-bool isValid(int x, int y, int M, int N) {
-    return (x < M && y < N) && (x >= 0 && y >= 0);
+// Function to check if it is safe to go to the cell at `index` from the
+// current position. The function returns false if it is unsafe or
+// already visited.
+bool isSafe(Grid<int> const &field, DenseBitset const &visited, size_t index) {
+    return field[index] != 0 && !visited[index];
 }
  
 // Find the minimum number of steps required to reach the last column
 // from the first column using BFS
-int BFS(vector<vector<int>> const &field)
+int BFS(Grid<int> const &field)
 {
     // `M × N` matrix
-    int M = field.size();
-    int N = field[0].size();
+    int M = field.rows();
+    int N = field.cols();
+ 
+    // the four movements as constant offsets in the grid
+    auto moves = field.neighborOffsets(row, col);
  
-    // stores if a cell is visited or not
-    vector<vector<bool>> visited;
-    visited.resize(M, vector<bool>(N));
+    // stores if a cell is visited or not, one bit per grid index
+    DenseBitset visited(field.size());
  
     // create an empty queue
     queue<Node> q;
@@ -50,10 +52,10 @@ int BFS(vector<vector<int>> const &field)
     {
         // if the cell is safe, mark it as visited and
         // enqueue it by assigning it distance as 0
-        if (field[r][0] == 1)
+        if (field(r, 0) == 1)
         {
-            q.push({r, 0, 0});
-            visited[r][0] = true;
+            q.push({field.index(r, 0), 0});
+            visited.set(field.index(r, 0));
         }
     }
  
@@ -61,27 +63,26 @@ int BFS(vector<vector<int>> const &field)
     while (!q.empty())
     {
         // dequeue front node and process it
-        int i = q.front().x;
-        int j = q.front().y;
+        size_t cell = q.front().cell;
         int dist = q.front().dist;
         q.pop();
  
         // if the destination is found, return minimum distance
-        if (j == N - 1) {
+        if (field.colOf(cell) == N - 1) {
             return dist;
         }
  
         // check for all four possible movements from the current cell
         // and enqueue each valid movement
-        for (int k = 0; k < 4; k++)
+        for (ptrdiff_t move: moves)
         {
-            // skip if the location is invalid or visited, or unsafe
-            if (isValid(i + row[k], j + col[k], M, N) &&
-                isSafe(field, visited, i + row[k], j + col[k]))
+            // skip if the location is visited or unsafe; border cells
+            // are unsafe
+            if (isSafe(field, visited, cell + move))
             {
                 // mark it as visited and enqueue it with +1 distance
-                visited[i + row[k]][j + col[k]] = true;
-                q.push({i + row[k], j + col[k], dist + 1});
+                visited.set(cell + move);
+                q.push({cell + move, dist + 1});
             }
         }
     }
@@ -90,31 +91,34 @@ int BFS(vector<vector<int>> const &field)
 }
  
 // Find the shortest path from the first column to the last column in a given field
-int findShortestDistance(vector<vector<int>> &mat)
+int findShortestDistance(Grid<int> &mat)
 {
     // base case
-    if (mat.size() == 0) {
+    if (mat.rows() == 0) {
         return 0;
     }
  
     // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
+    int M = mat.rows();
+    int N = mat.cols();
  
     // `r[]` and `c[]` detail all eight possible movements from a cell
     // (top, right, bottom, left, and four diagonal moves)
     int r[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
     int c[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+    auto around = mat.neighborOffsets(r, c);
  
-    // mark adjacent cells of sensors as unsafe
+    // mark adjacent cells of sensors as unsafe; only cells of the field are
+    // sensors, and the border cells next to them hold 0, so they are left
+    // alone
     for (int i = 0; i < M; i++)
     {
         for (int j = 0; j < N; j++)
         {
-            for (int k = 0; k < 8; k++) {
-                if (!mat[i][j] && isValid(i + r[k], j + c[k], M, N)
-                        && mat[i + r[k]][j + c[k]]) {
-                    mat[i + r[k]][j + c[k]] = INT_MAX;
+            size_t cell = mat.index(i, j);
+            for (ptrdiff_t move: around) {
+                if (!mat[cell] && mat[cell + move]) {
+                    mat[cell + move] = INT_MAX;
                 }
             }
         }
@@ -125,8 +129,8 @@ int findShortestDistance(vector<vector<int>> &mat)
     {
         for (int j = 0; j < N; j++)
         {
-            if (mat[i][j] == INT_MAX) {
-                mat[i][j] = 0;
+            if (mat(i, j) == INT_MAX) {
+                mat(i, j) = 0;
             }
         }
     }
@@ -151,7 +155,10 @@ int main()
         { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 }
     };
  
-    int dist = findShortestDistance(field);
+    // store the field in a flat grid with a ring of unsafe cells around it
+    Grid<int> grid(field, 0);
+ 
+    int dist = findShortestDistance(grid);
  
     if (dist != INT_MAX) {
         cout << "The shortest safe path has a length of " << dist;
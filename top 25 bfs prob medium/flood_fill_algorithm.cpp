@@ -1,76 +1,72 @@
 #include <iostream>
 #include <queue>
 #include <iomanip>
+#include "../common/grid.h"
+#include "../common/span_fill.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements
 int row[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
 int col[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
  
-// check if it is possible to go to pixel (x, y) from the
-// current pixel. The function returns false if the pixel
-// has a different color, or it's not a valid pixel
-bool isSafe(vector<vector<char>> const &mat, int x, int y, char target)
-{
-    return (x >= 0 && x < mat.size()) && (y >= 0 && y < mat[0].size())
-        && mat[x][y] == target;
-}
+// The screen is a `Grid` whose border ring holds '\0', a color no pixel
+// has, so a pixel beyond the edge never matches the target color and the
+// eight movements need no bounds check.
  
 // Flood fill using BFS
-void floodfill(vector<vector<char>> &mat, int x, int y, char replacement)
+void floodfill(Grid<char> &mat, int x, int y, char replacement)
 {
     // base case
-    if (mat.size() == 0) {
+    if (mat.rows() == 0) {
         return;
     }
  
-    // create a queue and enqueue starting pixel
-    queue<pair<int, int>> q;
-    q.push({x, y});
+    // the eight movements as constant offsets in the grid
+    auto moves = mat.neighborOffsets(row, col);
  
     // get the target color
-    char target = mat[x][y];
+    char target = mat(x, y);
  
     // target color is same as replacement
     if (target == replacement) {
         return;
     }
  
+    // create a queue and enqueue starting pixel; a pixel is recolored as
+    // soon as it is enqueued, so it cannot be enqueued a second time
+    queue<size_t> q;
+    mat(x, y) = replacement;
+    q.push(mat.index(x, y));
+ 
     // break when the queue becomes empty
     while (!q.empty())
     {
         // dequeue front node and process it
-        pair<int, int> node = q.front();
+        size_t pixel = q.front();
         q.pop();
  
-        // (x, y) represents the current pixel
-        int x = node.first, y = node.second;
- 
-        // replace the current pixel color with that of replacement
-        mat[x][y] = replacement;
- 
         // process all eight adjacent pixels of the current pixel and
         // enqueue each valid pixel
-        for (int k = 0; k < 8; k++)
+        for (ptrdiff_t move: moves)
         {
-            // if the adjacent pixel at position (x + row[k], y + col[k]) is
-            // is valid and has the same color as the current pixel
-            if (isSafe(mat, x + row[k], y + col[k], target))
+            // if the adjacent pixel has the target color, replace it
+            // and enqueue it
+            if (mat[pixel + move] == target)
             {
-                // enqueue adjacent pixel
-                q.push({x + row[k], y + col[k]});
+                mat[pixel + move] = replacement;
+                q.push(pixel + move);
             }
         }
     }
 }
  
 // Utility function to print a matrix
-void printMatrix(vector<vector<char>> const &mat)
+void printMatrix(Grid<char> const &mat)
 {
-    for (int i = 0; i < mat.size(); i++)
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < mat[0].size(); j++) {
-            cout << setw(3) << mat[i][j];
+        for (int j = 0; j < mat.cols(); j++) {
+            cout << setw(3) << mat(i, j);
         }
         cout << endl;
     }
@@ -79,7 +75,7 @@ void printMatrix(vector<vector<char>> const &mat)
 int main()
 {
     // matrix showing portion of the screen having different colors
-    vector<vector<char>> mat =
+    vector<vector<char>> screen =
     {
         { 'Y', 'Y', 'Y', 'G', 'G', 'G', 'G', 'G', 'G', 'G' },
         { 'Y', 'Y', 'Y', 'Y', 'Y', 'Y', 'G', 'X', 'X', 'X' },
@@ -93,6 +89,9 @@ int main()
         { 'W', 'B', 'B', 'X', 'X', 'X', 'X', 'X', 'X', 'X' }
     };
  
+    // store the screen in a flat grid with a ring of '\0' pixels around it
+    Grid<char> mat(screen, '\0');
+ 
     // start node
     int x = 3, y = 9;    // having target color `X`
  
@@ -100,11 +99,23 @@ int main()
     char replacement = 'C';
  
     // replace the target color with a replacement color
+    Grid<char> original = mat;
     floodfill(mat, x, y, replacement);
  
     // print the colors after replacement
     printMatrix(mat);
  
+    // the same fill a run of pixels at a time
+    Grid<char> spans = original;
+    spanFill(spans, x, y, replacement, EightConnected);
+    cout << "\nScanline fill gives the same screen: "
+         << (spans.toMatrix() == mat.toMatrix() ? "yes" : "no") << endl;
+ 
+    // without diagonal moves, the region of (3, 9) is smaller
+    Grid<char> four = original;
+    cout << "Pixels filled with 4-connectivity: "
+         << spanFill(four, x, y, replacement, FourConnected) << endl;
+ 
     return 0;
 }
 
@@ -121,5 +132,10 @@ int main()
 //  W  B  B  C  B  B  B  B  C  C
 //  W  B  B  C  C  C  C  C  C  C
 
+// Scanline fill gives the same screen: yes
+// Pixels filled with 4-connectivity: 27
+
 // The time complexity of the proposed solution is O(M × N) and 
-// requires O(M × N) extra space, where M and N are dimensions of the matrix.
\ No newline at end of file
+// requires O(M × N) extra space, where M and N are dimensions of the matrix.
+// The scanline fill takes O(M × N) time as well, but its extra space is
+// one entry per horizontal run of the region instead of one per pixel.
\ No newline at end of file
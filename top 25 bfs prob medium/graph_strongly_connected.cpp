@@ -1,6 +1,8 @@
 #include <iostream>
 #include <vector>
-#include <algorithm>
+#include "../common/csr_graph.h"
+#include "../common/parallel_csr_builder.h"
+#include "../common/parallel_scc.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -9,86 +11,36 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
     public:
  
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the directed graph
-        for (auto &edge: edges) {
-            adjList[edge.src].push_back(edge.dest);
-        }
-    }
+    // stores the directed graph in compressed sparse row form, built by a
+    // parallel counting sort of the edges on all threads of `pool`
+    Graph(vector<Edge> const &edges, int n, ThreadPool &pool)
+        : CSRGraph<int>(buildCSRGraphParallel(edges, n, Directed, pool)) {}
+
+    // wrap an already built CSR graph, e.g., its transpose
+    Graph(CSRGraph<int> &&graph): CSRGraph<int>(std::move(graph)) {}
 };
  
-// Function to perform DFS traversal on the graph on a graph
-void DFS(Graph const &graph, int v, vector<bool> &visited)
+// Function to check if the graph is strongly connected or not.
+// A forward and a backward search from the same vertex both covering the
+// whole graph is exactly the first step of a forward-backward SCC
+// decomposition, so the graph is decomposed into its strongly connected
+// components on all threads of `pool`, and it is strongly connected if
+// there is only one.
+int countStronglyConnectedComponents(Graph const &graph, ThreadPool &pool)
 {
-    // mark current node as visited
-    visited[v] = true;
+    // the backward searches follow the edges in reverse direction
+    Graph gr(transposeParallel(graph, pool));
  
-    // do for every edge (v, u)
-    for (int u: graph.adjList[v])
-    {
-        // `u` is not visited
-        if (!visited[u]) {
-            DFS(graph, u, visited);
-        }
-    }
+    return parallelStronglyConnectedComponents(graph, gr, pool).count;
 }
  
-// Function to check if the graph is strongly connected or not
-bool isStronglyConnected(Graph const &graph, int n)
-{
-    // to keep track of whether a vertex is visited or not
-    vector<bool> visited(n);
- 
-    // choose a random starting point
-    int v = 0;
- 
-    // run a DFS starting at `v`
-    DFS(graph, v, visited);
- 
-    // If DFS traversal doesn't visit all vertices,
-    // then the graph is not strongly connected
-    if (find(visited.begin(), visited.end(), false) != visited.end()) {
-        return false;
-    }
- 
-    // reset visited vector
-    fill(visited.begin(), visited.end(), false);
- 
-    // Reverse the direction of all edges in the directed graph
-    vector<Edge> edges;
-    for (int i = 0; i < n; i++)
-    {
-        for (int j: graph.adjList[i]) {
-            edges.push_back({j, i});
-        }
-    }
- 
-    // Create a graph from reversed edges
-    Graph gr(edges, n);
- 
-    // Again run a DFS starting at `v`
-    DFS(gr, v, visited);
- 
-    // If DFS traversal doesn't visit all vertices,
-    // then the graph is not strongly connected
-    if (find(visited.begin(), visited.end(), false) != visited.end()) {
-        return false;
-    }
- 
-    // if a graph "passes" both DFSs, it is strongly connected
-    return true;
+bool isStronglyConnected(Graph const &graph, ThreadPool &pool) {
+    return countStronglyConnectedComponents(graph, pool) == 1;
 }
  
 int main()
@@ -101,24 +53,37 @@ int main()
     // total number of nodes in the graph
     int n = 5;
  
+    // one thread per hardware thread
+    ThreadPool pool;
+ 
     // build a graph from the given edges
-    Graph graph(edges, n);
+    Graph graph(edges, n, pool);
  
     // check if the graph is not strongly connected or not
-    if (isStronglyConnected(graph, n)) {
-        cout << "The graph is strongly connected";
+    if (isStronglyConnected(graph, pool)) {
+        cout << "The graph is strongly connected" << endl;
     }
     else {
-        cout << "The graph is not strongly connected";
+        cout << "The graph is not strongly connected" << endl;
     }
  
+    // without the edge (4, 3), vertex 3 cannot be reached anymore
+    edges.pop_back();
+    Graph other(edges, n, pool);
+ 
+    cout << "Without the edge (4, 3), the graph has "
+         << countStronglyConnectedComponents(other, pool)
+         << " strongly connected components" << endl;
+ 
     return 0;
 }
 
 
 // Output:
 // The graph is strongly connected
+// Without the edge (4, 3), the graph has 4 strongly connected components
 
-// The time complexity of the above solution is O(V + E), 
+// The time complexity of the above solution is O(V + E) for a graph with one giant component and trivial ones, 
 // where V and E are the total number of vertices and edges in the graph, respectively. 
-// Please note that O(E) may vary between O(1) and O(V2), depending on how dense the graph is.
\ No newline at end of file
+// Please note that O(E) may vary between O(1) and O(V2), depending on how dense the graph is.
+// Every other component costs one forward-backward split of its part, and the parts are processed on all threads.
\ No newline at end of file
@@ -3,58 +3,54 @@
 #include <vector>
 #include <climits>
 #include <cstring>
+#include "../common/dense_bitset.h"
+#include "../common/grid.h"
+#include "../common/grid_search.h"
+#include "../common/bidirectional_bfs.h"
 using namespace std;
  
 // A Queue Node
 struct Node
 {
-    // (x, y) represents matrix cell coordinates, and
-    // `dist` represents their minimum distance from the source
-    int x, y, dist;
+    // `cell` is the grid index of a matrix cell, and
+    // `dist` represents its minimum distance from the source
+    size_t cell;
+    int dist;
 };
  
 // Below arrays detail all four possible movements from a cell
 int row[] = { -1, 0, 0, 1 };
 int col[] = { 0, -1, 1, 0 };
  
-// Function to check if it is possible to go to position (row, col)
-// from the current position. The function returns false if (row, col)
-// is not a valid position or has a value 0 or already visited.
-bool isValid(vector<vector<int>> const &mat, vector<vector<bool>> &visited,
-        int row, int col) {
-    return (row >= 0 && row < mat.size()) && (col >= 0 && col < mat[0].size())
-        && mat[row][col] && !visited[row][col];
-}
- 
-// Find the shortest possible route in a matrix `mat` from source
-// cell (i, j) to destination cell (x, y)
-int findShortestPathLength(vector<vector<int>> const &mat, pair<int, int> &src,
+// Find the shortest possible route in a maze from source cell (i, j) to
+// destination cell (x, y). The maze is a `Grid` whose border ring holds 0,
+// so stepping off the matrix looks like stepping into a wall, and no move
+// needs a bounds check.
+int findShortestPathLength(Grid<int> const &maze, pair<int, int> &src,
                     pair<int, int> &dest)
 {
     // base case: invalid input
-    if (mat.size() == 0 || mat[src.first][src.second] == 0 ||
-            mat[dest.first][dest.second] == 0) {
+    if (maze.rows() == 0 || maze(src.first, src.second) == 0 ||
+            maze(dest.first, dest.second) == 0) {
         return -1;
     }
  
-    // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
+    // the four movements as constant offsets in the grid
+    auto moves = maze.neighborOffsets(row, col);
  
-    // construct a `M × N` matrix to keep track of visited cells
-    vector<vector<bool>> visited;
-    visited.resize(M, vector<bool>(N));
+    // keep track of visited cells, one bit per grid index
+    DenseBitset visited(maze.size());
  
     // create an empty queue
     queue<Node> q;
-    
-    // get source cell (i, j)
-    int i = src.first;
-    int j = src.second;
+ 
+    // get source and destination cells
+    size_t source = maze.index(src.first, src.second);
+    size_t target = maze.index(dest.first, dest.second);
  
     // mark the source cell as visited and enqueue the source node
-    visited[i][j] = true;
-    q.push({i, j, 0});
+    visited.set(source);
+    q.push({source, 0});
  
     // stores length of the longest path from source to destination
     int min_dist = INT_MAX;
@@ -66,28 +62,23 @@ int findShortestPathLength(vector<vector<int>> const &mat, pair<int, int> &src,
         Node node = q.front();
         q.pop();
  
-        // (i, j) represents a current cell, and `dist` stores its
-        // minimum distance from the source
-        int i = node.x, j = node.y, dist = node.dist;
- 
         // if the destination is found, update `min_dist` and stop
-        if (i == dest.first && j == dest.second)
+        if (node.cell == target)
         {
-            min_dist = dist;
+            min_dist = node.dist;
             break;
         }
  
         // check for all four possible movements from the current cell
         // and enqueue each valid movement
-        for (int k = 0; k < 4; k++)
+        for (ptrdiff_t move: moves)
         {
-            // check if it is possible to go to position
-            // (i + row[k], j + col[k]) from current position
-            if (isValid(mat, visited, i + row[k], j + col[k]))
-            {
-                // mark next cell as visited and enqueue it
-                visited[i + row[k]][j + col[k]] = true;
-                q.push({ i + row[k], j + col[k], dist + 1 });
+            // it is possible to go to the next cell if it has a value 1
+            // (border cells are 0) and is not visited yet; mark it as
+            // visited and enqueue it
+            size_t next = node.cell + move;
+            if (maze[next] && !visited.testAndSet(next)) {
+                q.push({ next, node.dist + 1 });
             }
         }
     }
@@ -99,6 +90,35 @@ int findShortestPathLength(vector<vector<int>> const &mat, pair<int, int> &src,
     return -1;
 }
  
+// Same as `findShortestPathLength`, but searching from both ends at once
+// until the two searches meet; moves are symmetric, so the backward search
+// uses the same moves. `search` holds one entry per cell of the maze and
+// may serve any number of queries.
+int findShortestPathLengthBidirectional(BidirectionalBFS &search, Grid<int> const &maze,
+                    pair<int, int> &src, pair<int, int> &dest)
+{
+    if (maze.rows() == 0 || maze(src.first, src.second) == 0 ||
+            maze(dest.first, dest.second) == 0) {
+        return -1;
+    }
+ 
+    auto moves = maze.neighborOffsets(row, col);
+ 
+    // visit the open cells next to `cell`
+    auto neighbors = [&](int cell, auto &&visit)
+    {
+        for (ptrdiff_t move: moves)
+        {
+            if (maze[cell + move]) {
+                visit(cell + move);
+            }
+        }
+    };
+ 
+    return search.find(maze.index(src.first, src.second), maze.index(dest.first, dest.second),
+            neighbors, neighbors).length;
+}
+ 
 int main()
 {
     vector<vector<int>> mat =
@@ -118,7 +138,10 @@ int main()
     pair<int, int> src = make_pair(0, 0);
     pair<int, int> dest = make_pair(7, 5);
  
-    int min_dist = findShortestPathLength(mat, src, dest);
+    // store the matrix in a flat grid with a ring of walls around it
+    Grid<int> maze(mat, 0);
+ 
+    int min_dist = findShortestPathLength(maze, src, dest);
     if (min_dist != -1)
     {
         cout << "The shortest path from source to destination "
@@ -127,6 +150,26 @@ int main()
     else {
         cout << "Destination cannot be reached from a given source";
     }
+    cout << endl;
+ 
+    BidirectionalBFS bidirectional(maze.size());
+    cout << "Bidirectional BFS: length "
+         << findShortestPathLengthBidirectional(bidirectional, maze, src, dest) << endl;
+ 
+    // point-to-point searches guided towards the destination
+    size_t source = maze.index(src.first, src.second);
+    size_t target = maze.index(dest.first, dest.second);
+ 
+    // one search object serves any number of queries on the maze
+    GridPathSearch<int> search(maze);
+
+    GridSearchResult astar = search.aStar(source, target);
+    cout << "A* (Manhattan heuristic): length " << astar.length
+         << ", " << astar.expanded << " cells expanded" << endl;
+ 
+    GridSearchResult jps = search.jumpPoint(source, target);
+    cout << "Jump-point search: length " << jps.length
+         << ", " << jps.expanded << " jump points expanded" << endl;
  
     return 0;
 }
@@ -135,6 +178,13 @@ int main()
 // Output:
 
 // The shortest path from source to destination has length 12
+// Bidirectional BFS: length 12
+// A* (Manhattan heuristic): length 12, 13 cells expanded
+// Jump-point search: length 12, 10 jump points expanded
 
 // The time complexity of the proposed solution is O(M × N) and 
-// requires O(M × N) extra space, where M and N are dimensions of the matrix.
\ No newline at end of file
+// requires O(M × N) extra space, where M and N are dimensions of the matrix.
+// A* and jump-point search have the same worst case, but only expand the
+// cells (or jump points) whose distance plus Manhattan distance to the
+// destination is at most the path length, which on open ground is a narrow
+// band around the path.
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <vector>
 #include <cstring>
 #include <iomanip>
+#include <numeric>
+#include "../common/csr_graph.h"
+#include "../common/multi_source_bfs.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -11,44 +14,25 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        adjList.resize(n);
- 
-        // add edges to the directed graph
-        for (Edge edge: edges)
-        {
-            int src = edge.src;
-            int dest = edge.dest;
- 
-            adjList[src].push_back(dest);
-        }
-    }
+    // stores the directed graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Directed) {}
 };
  
-// `C` is a connectivity matrix and stores transitive closure of a graph
-// `root` is the topmost node in DFS tree (it is the starting vertex of DFS)
-// `descendant` is current vertex to be explored in DFS.
-// Invariant: A path already exists in the graph from `root` to `descendant`
-void DFS(Graph const &graph, vector<vector<bool>> &C, int root, int descendant)
+// Compute the connectivity matrix `C` of the graph, i.e., its transitive
+// closure. Row `v` is the set of vertices reachable from `v`. Instead of one
+// traversal per vertex, a bit-parallel multi-source BFS runs the searches of
+// 256 vertices at once, so every scan of an arc serves all of them.
+vector<DenseBitset> transitiveClosure(Graph const &graph, int n)
 {
-    for (int child: graph.adjList[descendant])
-    {
-        // if `child` is an adjacent vertex of descendant, we have
-        // found a path from root->child
-        if (!C[root][child])
-        {
-            C[root][child] = true;
-            DFS(graph, C, root, child);
-        }
-    }
+    // start a search from every vertex
+    vector<int> sources(n);
+    iota(sources.begin(), sources.end(), 0);
+ 
+    return multiSourceReachability<4>(graph, sources);
 }
  
 int main()
@@ -67,14 +51,10 @@ int main()
     // `C` is a connectivity matrix and stores the transitive closure
     // of the graph. The value of `C[i][j]` is 1 only if a directed
     // path exists from vertex `i` to vertex `j`.
-    vector<vector<bool>> C(n, vector<bool>(n, false));
+    vector<DenseBitset> C = transitiveClosure(graph, n);
  
-    // consider each vertex and start DFS from it
     for (int v = 0; v < n; v++)
     {
-        C[v][v] = true;
-        DFS(graph, C, v, v);
- 
         // print path info for vertex `v`
         for (int u = 0; u < n; u++) {
             cout << left << setw(4) << C[v][u];
@@ -91,4 +71,6 @@ int main()
 // 1   0   1   0
 // 1   1   1   0
 // 0   0   1   0
-// 1   1   1   1
\ No newline at end of file
+// 1   1   1   1
+
+// The searches run in ⌈V / 256⌉ batches of O(V + E) word operations each, instead of V separate traversals.
\ No newline at end of file
@@ -26,90 +26,31 @@
 
 #include <iostream>
 #include <vector>
-#include <set>
+#include <algorithm>
+#include "../common/csr_graph.h"
+#include "../common/bridges.h"
 using namespace std;
  
 typedef pair<int, int> Edge;
  
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Graph Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the undirected graph
-        for (auto &edge: edges)
-        {
-            adjList[edge.first].push_back(edge.second);
-            adjList[edge.second].push_back(edge.first);
-        }
-    }
+    // stores the undirected graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Undirected) {}
 };
  
-// Perform DFS on the graph starting from vertex `v` and find
-// all bridges in the process
-int DFS(Graph const &graph, int v, vector<bool> visited, vector<int> &arrival,
-        int parent, int &time, auto &bridges)
+// Find all bridges of the graph, together with its articulation points and
+// 2–edge connected components. The DFS runs with an explicit stack and is
+// restarted from every unvisited vertex, so the graph does not need to be
+// connected. The bridges are returned sorted.
+BridgeResult findBridges(Graph const &graph)
 {
-    // set the arrival time of vertex `v`
-    arrival[v] = ++time;
- 
-    // mark vertex as visited
-    visited[v] = true;
- 
-    // initialize `t` with the arrival time of vertex `v`
-    int t = arrival[v];
- 
-    // (v, w) forms an edge
-    for (int w: graph.adjList[v])
-    {
-        // if `w` is not visited
-        if (!visited[w]) {
-            t = min(t, DFS(graph, w, visited, arrival, v, time, bridges));
-        }
-        // if `w` is visited, and `w` is not a parent of `v`
-        else if (w != parent)
-        {
-            // If vertex `w` is already visited, there is a back edge starting
-            // from `v`. Note that as visited[u] is already
-            // true, arrival[u] is already defined
-            t = min(t, arrival[w]);
-        }
-    }
- 
-    // if the value of `t` remains unchanged, i.e., it is equal
-    // to the arrival time of vertex `v`, and if `v` is not the root node,
-    // then (parent[v] —> v) forms a bridge
-    if (t == arrival[v] && parent != -1) {
-        bridges.insert({parent, v});
-    }
+    BridgeResult result = findBridgesAndArticulationPoints(graph);
+    sort(result.bridges.begin(), result.bridges.end());
  
-    // return the minimum arrival time
-    return t;
-}
- 
-set<Edge> findBridges(Graph const &graph, int n)
-{
-    // to keep track of whether a vertex is visited or not
-    vector<bool> visited(n);
- 
-    // stores arrival time of a node in DFS
-    vector<int> arrival(n);
- 
-    int start = 0, parent = -1, time = 0;
- 
-    set<Edge> bridges;
- 
-    // As the given graph is connected, DFS will cover every node
-    DFS(graph, start, visited, arrival, parent, time, bridges);
- 
-    return bridges;
+    return result;
 }
  
 void printEdges(auto const &edges)
@@ -134,13 +75,29 @@ int main()
     Graph graph(edges, n);
  
     // find and print bridges
-    auto bridges = findBridges(graph, n);
+    BridgeResult result = findBridges(graph);
+    auto &bridges = result.bridges;
  
     if (bridges.size() != 0) {
         cout << "Bridges are "; printEdges(bridges);
     } else {
         cout << "Graph is 2– Connected";
     }
+    cout << endl;
+ 
+    // removing any of these vertices disconnects the graph
+    cout << "Articulation points are ";
+    for (int v: result.articulationPoints) {
+        cout << v << ' ';
+    }
+    cout << endl;
+ 
+    // vertices that stay connected once all bridges are removed
+    cout << "2–edge connected component of each vertex: ";
+    for (int v = 0; v < n; v++) {
+        cout << result.component[v] << ' ';
+    }
+    cout << endl;
  
     return 0;
 }
@@ -148,8 +105,10 @@ int main()
 
 // Output:
 
-// Bridges are (0, 2) (2, 1) (3, 5)
+// Bridges are (0, 2) (2, 1) (3, 5) 
+// Articulation points are 2 3 
+// 2–edge connected component of each vertex: 3 0 2 2 2 1 4 5 6 7 
 
  
-// The time complexity of the above solution is O(V + E), 
+// The time complexity of the above solution is O(V + E), with O(V) extra space in flat arrays, 
 // where V and E are the total number of vertices and edges in the graph, respectively.
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include "../common/csr_graph.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -9,24 +10,16 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
     public:
  
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the directed graph
-        for (auto &edge: edges) {
-            adjList[edge.src].push_back(edge.dest);
-        }
-    }
+    // stores the directed graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Directed) {}
+
+    // wrap an already built CSR graph, e.g., its transpose
+    Graph(CSRGraph<int> &&graph): CSRGraph<int>(std::move(graph)) {}
 };
  
 // Function to perform DFS traversal on the graph on a graph
@@ -36,7 +29,7 @@ void DFS(Graph const &graph, int v, vector<bool> &visited)
     visited[v] = true;
  
     // do for every edge (v, u)
-    for (int u: graph.adjList[v])
+    for (int u: graph.neighbors(v))
     {
         // `u` is not visited
         if (!visited[u]) {
@@ -66,17 +59,8 @@ bool isStronglyConnected(Graph const &graph, int n)
     // reset visited vector
     fill(visited.begin(), visited.end(), false);
  
-    // Reverse the direction of all edges in the directed graph
-    vector<Edge> edges;
-    for (int i = 0; i < n; i++)
-    {
-        for (int j: graph.adjList[i]) {
-            edges.push_back({j, i});
-        }
-    }
- 
-    // Create a graph from reversed edges
-    Graph gr(edges, n);
+    // Create a graph with the direction of all edges reversed
+    Graph gr(graph.transpose());
  
     // Again run a DFS starting at `v`
     DFS(gr, v, visited);
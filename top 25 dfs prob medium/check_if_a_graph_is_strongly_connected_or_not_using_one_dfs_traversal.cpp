@@ -14,9 +14,13 @@
 
 // This is demonstrated below in C++, Java, and Python:
 
+// The same single DFS, extended with a stack of not yet completed vertices, is Tarjan's algorithm: instead of stopping at the first subtree with no edge going out of it, it cuts that subtree off as a strongly connected component and continues. The version below runs it with an explicit stack instead of recursion, so long chains of vertices cannot overflow the call stack, and it labels every vertex with its component. The graph is strongly connected if and only if there is exactly one component.
+
 
 #include <iostream>
 #include <vector>
+#include "../common/csr_graph.h"
+#include "../common/strongly_connected_components.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -24,96 +28,36 @@ struct Edge {
     int src, dest;
 };
  
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Graph Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the directed graph
-        for (auto &edge: edges) {
-            adjList[edge.src].push_back(edge.dest);
-        }
-    }
+    // stores the directed graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Directed) {}
 };
  
-// Perform DFS on the graph starting from vertex `v`
-int DFS(Graph const &graph, int v, vector<bool> &discovered,
-    vector<int> &arrival, bool &isSC, int &time)
-{
-    // terminate the search if the graph is not strongly connected
-    if (!isSC) {
-        return 0;
-    }
- 
-    // set the arrival time of vertex `v`
-    arrival[v] = ++time;
- 
-    // mark vertex as discovered
-    discovered[v] = true;
- 
-    // initialize `arr` to the arrival time of vertex `v`
-    int arr = arrival[v];
- 
-    // do for every edge (v, w)
-    for (int w: graph.adjList[v])
-    {
-        // vertex `w` is not yet explored
-        if (!discovered[w]) {
-            arr = min(arr, DFS(graph, w, discovered, arrival, isSC, time));
-        }
-        // vertex `w` is explored before
-        else {
-            // If the vertex is `w` is already discovered, there must be
-            // either a cross edge or a back edge starting from `v`.
-            // Note that the arrival time is already defined for `w`.
-            arr = min(arr, arrival[w]);
-        }
-    }
- 
-    // if `v` is not a root node and the value of `arr` didn't
-    // change, i.e., it is still set to the arrival time of
-    // vertex `v`, the graph is not strongly connected
-    if (v != 0 && arr == arrival[v]) {
-        isSC = false;
-    }
- 
-    // we return the minimum arrival time
-    return arr;
+// Function to check if the graph is strongly connected or not
+bool isStronglyConnected(SCCResult const &scc) {
+    return scc.count == 1;
 }
  
-// Function to check if the graph is strongly connected or not
-bool isStronglyConnected(Graph const &graph, int n)
+// Print the component of every vertex, the size of every component, and
+// the number of edges between different components
+void printComponents(Graph const &graph, SCCResult const &scc)
 {
-    // to keep track of whether a vertex is discovered or not
-    vector<bool> discovered(n);
- 
-    // array to store the arrival time of vertex
-    vector<int> arrival(n);
- 
-    // flag to determine if a graph is strongly connected or not
-    bool isSC = true;
-    int time = -1;
- 
-    // Perform DFS traversal starting from the first vertex.
-    DFS(graph, 0, discovered, arrival, isSC, time);
+    cout << "Component of each vertex:";
+    for (int v = 0; v < graph.numVertices(); v++) {
+        cout << " " << scc.component[v];
+    }
+    cout << endl;
  
-    // If DFS traversal doesn't visit all vertices,
-    // then the graph is not strongly connected
-    for (int i = 0; i < n; i++)
-    {
-        if (discovered[i] == false) {
-            isSC = false;
-        }
+    cout << "Component sizes:";
+    for (int c = 0; c < scc.count; c++) {
+        cout << " " << scc.size[c];
     }
+    cout << endl;
  
-    return isSC;
+    cout << "Edges in the condensation: " << countCondensationArcs(graph, scc) << endl;
 }
  
 // Check if the given graph is strongly connected or not
@@ -130,12 +74,31 @@ int main()
     // build a graph from the given edges
     Graph graph(edges, n);
  
-    if (isStronglyConnected(graph, n)) {
-        cout << "The graph is strongly connected";
+    // label every vertex with its strongly connected component
+    SCCResult scc = stronglyConnectedComponents(graph);
+ 
+    if (isStronglyConnected(scc)) {
+        cout << "The graph is strongly connected" << endl;
+    }
+    else {
+        cout << "The graph is not strongly connected" << endl;
+    }
+    printComponents(graph, scc);
+ 
+    // without the edge (4, 3), no vertex can reach 3 and the graph
+    // splits into four components
+    edges.pop_back();
+    Graph other(edges, n);
+    scc = stronglyConnectedComponents(other);
+ 
+    cout << endl;
+    if (isStronglyConnected(scc)) {
+        cout << "The graph is strongly connected" << endl;
     }
     else {
-        cout << "The graph is not strongly connected";
+        cout << "The graph is not strongly connected" << endl;
     }
+    printComponents(other, scc);
  
     return 0;
 }
@@ -144,7 +107,15 @@ int main()
 // Output:
 
 // The graph is strongly connected
+// Component of each vertex: 0 0 0 0 0
+// Component sizes: 5
+// Edges in the condensation: 0
+//
+// The graph is not strongly connected
+// Component of each vertex: 1 2 2 3 0
+// Component sizes: 1 1 2 1
+// Edges in the condensation: 4
 
-// The time complexity of the above solution is O(V + E), 
+// The time complexity of the above solution is O(V + E), and it needs one int and one bit per vertex besides the stacks, 
 // where V and E are the total number of vertices and edges in the graph, respectively. 
 // Please note that O(E) may vary between O(1) and O(V2), depending on how dense the graph is.
\ No newline at end of file
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <iostream>
-#include <stack>
 #include <vector>
+#include "../common/compressed_graph.h"
+#include "../common/csr_graph.h"
+#include "../common/dense_bitset.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -9,63 +12,55 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Graph Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the undirected graph
-        for (auto &edge: edges)
-        {
-            adjList[edge.src].push_back(edge.dest);
-            adjList[edge.dest].push_back(edge.src);
-        }
-    }
+    // stores the undirected graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Undirected) {}
 };
  
-// Perform iterative DFS on graph starting from vertex `v`
-void iterativeDFS(Graph const &graph, int v, vector<bool> &discovered)
+// Perform iterative DFS on graph starting from vertex `v`; `Graph` may be the
+// CSR graph above or a `CompressedGraph`, whose neighbors are decoded on the fly
+template <typename Graph>
+void iterativeDFS(Graph const &graph, int v, DenseBitset &discovered)
 {
     // create a stack used to do iterative DFS
-    stack<int> stack;
+    vector<int> stack;
  
     // push the source node into the stack
-    stack.push(v);
+    stack.push_back(v);
  
     // loop till stack is empty
     while (!stack.empty())
     {
         // Pop a vertex from the stack
-        v = stack.top();
-        stack.pop();
+        v = stack.back();
+        stack.pop_back();
  
         // if the vertex is already discovered yet,
         // ignore it
-        if (discovered[v]) {
+        if (discovered.testAndSet(v)) {
             continue;
         }
  
-        // we will reach here if the popped vertex `v` is not discovered yet;
+        // we will reach here if the popped vertex `v` is not discovered yet
+        // (and `testAndSet` has just marked it);
         // print `v` and process its undiscovered adjacent nodes into the stack
-        discovered[v] = true;
         cout << v << " ";
  
         // do for every edge (v, u)
-        // we are using reverse iterator (Why?)
-        for (auto it = graph.adjList[v].rbegin(); it != graph.adjList[v].rend(); it++)
+        // the neighbors must end up on the stack in reverse order (Why?);
+        // they are pushed in order and the pushed block is reversed, since
+        // compressed neighbor lists can only be decoded front to back
+        size_t pushed = stack.size();
+        for (int u: graph.neighbors(v))
         {
-            int u = *it;
-            if (!discovered[u]) {
-                stack.push(u);
+            if (!discovered.test(u)) {
+                stack.push_back(u);
             }
         }
+        reverse(stack.begin() + pushed, stack.end());
     }
 }
  
@@ -86,16 +81,30 @@ int main()
     Graph graph(edges, n);
  
     // to keep track of whether a vertex is discovered or not
-    vector<bool> discovered(n);
+    DenseBitset discovered(n);
  
     // Do iterative DFS traversal from all undiscovered nodes to
-    // cover all connected components of a graph
-    for (int i = 0; i < n; i++)
-    {
-        if (discovered[i] == false) {
-            iterativeDFS(graph, i, discovered);
-        }
+    // cover all connected components of a graph; `findNextUnset` skips
+    // over 64 discovered vertices at a time
+    for (int i = discovered.findNextUnset(0); i < n; i = discovered.findNextUnset(i + 1)) {
+        iterativeDFS(graph, i, discovered);
+    }
+    cout << endl;
+ 
+    // the same traversal over gap-encoded neighbor lists; the neighbors
+    // of every vertex above are already in increasing order, so the
+    // visiting order does not change
+    CompressedGraph compressed(graph);
+    discovered.clear();
+ 
+    for (int i = discovered.findNextUnset(0); i < n; i = discovered.findNextUnset(i + 1)) {
+        iterativeDFS(compressed, i, discovered);
     }
+    cout << endl;
+ 
+    cout << "CSR graph: " << graph.offsets.size() * sizeof(size_t) +
+            graph.targets.size() * sizeof(int) << " bytes, compressed: " <<
+            compressed.memoryBytes() << " bytes" << endl;
  
     return 0;
 }
@@ -103,4 +112,6 @@ int main()
 
 // Output:
 
-// 0 1 2 3 4 5 6 7 8 9 10 11 12
\ No newline at end of file
+// 0 1 2 3 4 5 6 7 8 9 10 11 12
+// 0 1 2 3 4 5 6 7 8 9 10 11 12
+// CSR graph: 200 bytes, compressed: 95 bytes
\ No newline at end of file
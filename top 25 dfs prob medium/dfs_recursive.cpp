@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include "../common/csr_graph.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -8,25 +9,12 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Graph Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        // resize the vector to hold `n` elements of type `vector<int>`
-        adjList.resize(n);
- 
-        // add edges to the undirected graph
-        for (auto &edge: edges)
-        {
-            adjList[edge.src].push_back(edge.dest);
-            adjList[edge.dest].push_back(edge.src);
-        }
-    }
+    // stores the undirected graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Undirected) {}
 };
  
 // Function to perform DFS traversal on the graph on a graph
@@ -39,7 +27,7 @@ void DFS(Graph const &graph, int v, vector<bool> &discovered)
     cout << v << " ";
  
     // do for every edge (v, u)
-    for (int u: graph.adjList[v])
+    for (int u: graph.neighbors(v))
     {
         // if `u` is not yet discovered
         if (!discovered[u]) {
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <string>
+#include "../common/grid.h"
 using namespace std;
  
 template <typename T>
@@ -17,65 +20,66 @@ void printVectorOfPairs(vector<pair<T,T>> const &input)
     cout << "]\n";
 }
  
-// Function to check if it is possible to go to position next
-// from the current position. The function returns false if next is
-// not in a valid position, or it is already visited
-bool isValid(pair<int,int> const &next, vector<pair<int,int>> const &path,
-    vector<vector<char>> const &mat)
-{
-    return (next.first >= 0 && next.first < mat.size()) &&
-            (next.second >= 0 && next.second < mat[0].size()) &&
-            find(path.begin(), path.end(), next) == path.end();
+// Below arrays detail all eight possible movements from a cell
+// (top, right, bottom, left, and four diagonal moves)
+int row[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+int col[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+ 
+// The matrix is a `Grid` whose border ring holds '\0', which no word
+// contains, so a cell beyond the edge never matches the next character and
+// the eight movements need no bounds check. Cells are grid indices.
+ 
+// Function to check if it is possible to go to cell `next` from the current
+// position. The function returns false if `next` is already on the path.
+bool isValid(size_t next, vector<size_t> const &path) {
+    return find(path.begin(), path.end(), next) == path.end();
 }
  
 // Notice that the path vector is not passed by the reference (Why?).
 // Use backtracking if the vector is passed by reference
-void DFS(vector<vector<char>> const &mat, string word, pair<int,int> const &next,
-        vector<pair<int,int>> path, int index)
+void DFS(Grid<char> const &mat, array<ptrdiff_t, 8> const &moves, string const &word,
+        size_t next, vector<size_t> path, size_t index)
 {
-    int i = next.first;
-    int j = next.second;
- 
     // return if characters don't match
-    if (mat[i][j] != word[index]) {
+    if (mat[next] != word[index]) {
         return;
     }
  
     // include the current cell in the path
-    path.push_back({i, j});
+    path.push_back(next);
  
     // if all words are matched, print the result and return
-    if (index == word.size() - 1)    {
-        printVectorOfPairs(path);
+    if (index == word.size() - 1)
+    {
+        vector<pair<int,int>> cells;
+        for (size_t cell: path) {
+            cells.push_back({mat.rowOf(cell), mat.colOf(cell)});
+        }
+        printVectorOfPairs(cells);
         return;
     }
  
-    // Below arrays detail all eight possible movements from a cell
-    // (top, right, bottom, left, and four diagonal moves)
-    int row[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
-    int col[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
- 
     // check all eight possible movements from the current cell
     // and recur for each valid movement
-    for (int k = 0; k < 8; k++)
+    for (ptrdiff_t move: moves)
     {
-        // calculate the next position
-        pair<int,int> next = {i + row[k], j + col[k]};
- 
         // check if it is possible to go to the next position
         // from the current position
-        if (isValid(next, path, mat)) {
-            DFS(mat, word, next, path, index + 1);
+        if (isValid(next + move, path)) {
+            DFS(mat, moves, word, next + move, path, index + 1);
         }
     }
 }
  
-void findAllOccurences(vector<vector<char>> const &mat, string word)
+void findAllOccurences(Grid<char> const &mat, string const &word)
 {
-    for (int i = 0; i < mat.size(); i++)
+    // the eight movements as constant offsets in the grid
+    auto moves = mat.neighborOffsets(row, col);
+ 
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < mat[0].size(); j++) {
-            DFS(mat, word, make_pair(i, j), {}, 0);
+        for (int j = 0; j < mat.cols(); j++) {
+            DFS(mat, moves, word, mat.index(i, j), {}, 0);
         }
     }
 }
@@ -93,7 +97,8 @@ int main()
  
     string word = "CODE";
  
-    findAllOccurences(mat, word);
+    // store the matrix in a flat grid with a ring of '\0' around it
+    findAllOccurences(Grid<char>(mat, '\0'), word);
  
     return 0;
 }
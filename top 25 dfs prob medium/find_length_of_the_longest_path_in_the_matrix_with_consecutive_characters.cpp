@@ -1,28 +1,26 @@
 #include <iostream>
 #include <vector>
+#include <array>
+#include "../common/grid.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements
 int row[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
 int col[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
  
-// check whether cell (x, y) is valid or not
-bool isValid(int x, int y, int M, int N) {
-    return (x >= 0 && x < M && y >= 0 && y < N);
-}
+// The matrix is a `Grid` whose border ring holds '\0', which follows no
+// letter, so a path stops at the edge of the matrix like at any cell that
+// does not continue it, and the eight movements need no bounds check.
  
 // Find the length of the longest path in matrix `mat[][]` with consecutive characters.
 // The path should continue from the previous character.
-// Here, (i, j) denotes the coordinates of the current cell.
-int findMaxLen(vector<vector<char>> const &mat, int x, int y, char previous)
+// Here, `cell` is the index of the current cell in the grid.
+int findMaxLen(Grid<char> const &mat, array<ptrdiff_t, 8> const &moves, size_t cell,
+        char previous)
 {
-    // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
- 
-    // base case: return length 0 if the current cell (x, y) is invalid or
-    // the current character is not consecutive to the previous character
-    if (!isValid(x, y, M, N) || previous + 1 != mat[x][y]) {
+    // base case: return length 0 if the current character is not
+    // consecutive to the previous character, or is the border
+    if (previous + 1 != mat[cell] || mat[cell] == '\0') {
         return 0;
     }
  
@@ -30,11 +28,10 @@ int findMaxLen(vector<vector<char>> const &mat, int x, int y, char previous)
     int max_length = 0;
  
     // recur for all eight adjacent cells from the current cell
-    for (int k = 0; k < 8; k++)
+    for (ptrdiff_t move: moves)
     {
-        // visit position (x + row[k], y + col[k]) and find the
-        // maximum length from that path
-        int len = findMaxLen(mat, x + row[k], y + col[k], mat[x][y]);
+        // visit the adjacent cell and find the maximum length from that path
+        int len = findMaxLen(mat, moves, cell + move, mat[cell]);
  
         // update the length of the longest path if required
         max_length = max(max_length, 1 + len);
@@ -43,35 +40,35 @@ int findMaxLen(vector<vector<char>> const &mat, int x, int y, char previous)
     return max_length;
 }
  
-int findMaxLength(vector<vector<char>> const &mat, char ch)
+int findMaxLength(Grid<char> const &mat, char ch)
 {
     // base case
-    if (mat.size() == 0) {
+    if (mat.rows() == 0) {
         return 0;
     }
  
-    // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
+    // the eight movements as constant offsets in the grid
+    auto moves = mat.neighborOffsets(row, col);
  
     // stores length of the longest path
     int max_length = 0;
  
     // traverse the matrix
-    for (int x = 0; x < M; x++)
+    for (int x = 0; x < mat.rows(); x++)
     {
-        for (int y = 0; y < N; y++)
+        for (int y = 0; y < mat.cols(); y++)
         {
             // start from the current cell if its value matches with
             // the given character
-            if (mat[x][y] == ch)
+            size_t cell = mat.index(x, y);
+            if (mat[cell] == ch)
             {
                 // recur for all eight adjacent cells from the current cell
-                for (int k = 0; k < 8; k++)
+                for (ptrdiff_t move: moves)
                 {
-                    // visit position (x + row[k], y + col[k]) and find the
-                    // maximum length from that path
-                    int len = findMaxLen(mat, x + row[k], y + col[k], ch);
+                    // visit the adjacent cell and find the maximum length
+                    // from that path
+                    int len = findMaxLen(mat, moves, cell + move, ch);
  
                     // update the length of the longest path if required
                     max_length = max(max_length, 1 + len);
@@ -98,9 +95,12 @@ int main()
     // starting character
     char ch = 'C';
  
+    // store the matrix in a flat grid with a ring of '\0' around it
+    Grid<char> grid(mat, '\0');
+ 
     cout << "The length of the longest path with consecutive characters "
          << "starting from character " << ch << " is "
-         << findMaxLength(mat, ch) << endl;
+         << findMaxLength(grid, ch) << endl;
  
     return 0;
 }
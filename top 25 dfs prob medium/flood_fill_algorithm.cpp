@@ -1,59 +1,64 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <array>
+#include "../common/grid.h"
+#include "../common/span_fill.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements
 int row[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
 int col[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
  
-// check if it is possible to go to pixel (x, y) from the
-// current pixel. The function returns false if the pixel
-// has a different color, or it's not a valid pixel
-bool isSafe(vector<vector<char>> const &mat, int x, int y, char target)
+// The screen is a `Grid` whose border ring holds '\0', a color no pixel
+// has, so a pixel beyond the edge never matches the target color and the
+// eight movements need no bounds check.
+ 
+// Flood fill using DFS from pixel `pixel` (a grid index), replacing
+// `target` by `replacement`
+void floodfill(Grid<char> &mat, array<ptrdiff_t, 8> const &moves, size_t pixel, char target,
+        char replacement)
 {
-    return (x >= 0 && x < mat.size()) && (y >= 0 && y < mat[0].size())
-        && mat[x][y] == target;
+    // replace the current pixel color with that of replacement
+    mat[pixel] = replacement;
+ 
+    // process all eight adjacent pixels of the current pixel and
+    // recur for each one that has the same color as the current pixel had
+    for (ptrdiff_t move: moves)
+    {
+        if (mat[pixel + move] == target) {
+            floodfill(mat, moves, pixel + move, target, replacement);
+        }
+    }
 }
  
 // Flood fill using DFS
-void floodfill(vector<vector<char>> &mat, int x, int y, char replacement)
+void floodfill(Grid<char> &mat, int x, int y, char replacement)
 {
     // base case
-    if (mat.size() == 0) {
+    if (mat.rows() == 0) {
         return;
     }
  
     // get the target color
-    char target = mat[x][y];
+    char target = mat(x, y);
  
     // target color is same as replacement
     if (target == replacement) {
         return;
     }
  
-    // replace the current pixel color with that of replacement
-    mat[x][y] = replacement;
- 
-    // process all eight adjacent pixels of the current pixel and
-    // recur for each valid pixel
-    for (int k = 0; k < 8; k++)
-    {
-        // if the adjacent pixel at position (x + row[k], y + col[k]) is
-        // a valid pixel and has the same color as that of the current pixel
-        if (isSafe(mat, x + row[k], y + col[k], target)) {
-            floodfill(mat, x + row[k], y + col[k], replacement);
-        }
-    }
+    // the eight movements as constant offsets in the grid
+    floodfill(mat, mat.neighborOffsets(row, col), mat.index(x, y), target, replacement);
 }
  
 // Utility function to print a matrix
-void printMatrix(vector<vector<char>> const &mat)
+void printMatrix(Grid<char> const &mat)
 {
-    for (int i = 0; i < mat.size(); i++)
+    for (int i = 0; i < mat.rows(); i++)
     {
-        for (int j = 0; j < mat[0].size(); j++) {
-            cout << setw(3) << mat[i][j];
+        for (int j = 0; j < mat.cols(); j++) {
+            cout << setw(3) << mat(i, j);
         }
         cout << endl;
     }
@@ -82,11 +87,22 @@ int main()
     // replacement color
     char replacement = 'C';
  
+    // store the screen in a flat grid with a ring of '\0' around it
+    Grid<char> screen(mat, '\0');
+ 
     // replace the target color with a replacement color using DFS
-    floodfill(mat, x, y, replacement);
+    Grid<char> original = screen;
+    floodfill(screen, x, y, replacement);
  
     // print the colors after replacement
-    printMatrix(mat);
+    printMatrix(screen);
+ 
+    // the same fill with no recursion, a run of pixels at a time, for
+    // regions too large for the call stack
+    Grid<char> spans = original;
+    spanFill(spans, x, y, replacement, EightConnected);
+    cout << "\nScanline fill gives the same screen: "
+         << (spans.toMatrix() == screen.toMatrix() ? "yes" : "no") << endl;
  
     return 0;
 }
@@ -105,5 +121,9 @@ int main()
 //  W  B  B  C  B  B  B  B  C  C
 //  W  B  B  C  C  C  C  C  C  C
 
+// Scanline fill gives the same screen: yes
+
 // The time complexity of the proposed solution is O(M × N) and requires O(M × N) extra space, 
-// where M and N are dimensions of the matrix.
\ No newline at end of file
+// where M and N are dimensions of the matrix.
+// The scanline fill also takes O(M × N) time, and keeps one stack entry per
+// horizontal run of the region instead of a call frame per pixel.
\ No newline at end of file
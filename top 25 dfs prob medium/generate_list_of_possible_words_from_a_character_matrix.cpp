@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <unordered_set>
 #include <string>
+#include "../common/dense_bitset.h"
+#include "../common/grid.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements from a cell
@@ -10,23 +12,27 @@ using namespace std;
 int row[] = { -1, -1, -1, 0, 1, 0, 1, 1 };
 int col[] = { -1, 1, 0, -1, -1, 1, 0, 1 };
  
-// Function to check if it is safe to go to cell (x, y) from the current cell.
-// The function returns false if (x, y) is not valid matrix coordinates
-// or cell (x, y) is already processed.
-bool isSafe(int x, int y, auto &processed) {
-    return (x >= 0 && x < processed.size()) && (y >= 0 && y < processed[0].size()) &&
-        !processed[x][y];
+// The board is a `Grid` whose border ring holds '\0', so a cell beyond the
+// edge is told apart by its value and the eight movements need no bounds
+// check. Cells are grid indices, and the processed marks are one bit per
+// index of the grid.
+ 
+// Function to check if it is safe to go to `cell` from the current cell.
+// The function returns false if `cell` is on the border or it is already
+// processed.
+bool isSafe(Grid<char> const &board, size_t cell, DenseBitset const &processed) {
+    return board[cell] != '\0' && !processed.test(cell);
 }
  
 // A recursive function to generate all possible words in a boggle
-void searchBoggle(auto const &board, auto const &words, auto &result, auto &processed,
-                int i, int j, string path)
+void searchBoggle(Grid<char> const &board, auto const &moves, auto const &words, auto &result,
+                DenseBitset &processed, size_t cell, string path)
 {
     // mark the current node as processed
-    processed[i][j] = true;
+    processed.set(cell);
  
     // update the path with the current character and insert it into the set
-    path += board[i][j];
+    path += board[cell];
  
     // check whether the path is present in the input set
     if (words.find(path) != words.end()) {
@@ -34,41 +40,40 @@ void searchBoggle(auto const &board, auto const &words, auto &result, auto &proc
     }
  
     // check for all eight possible movements from the current cell
-    for (int k = 0; k < 8; k++)
+    for (ptrdiff_t move: moves)
     {
         // skip if a cell is invalid, or it is already processed
-        if (isSafe(i + row[k], j + col[k], processed)) {
-            searchBoggle(board, words, result, processed, i + row[k], j + col[k], path);
+        if (isSafe(board, cell + move, processed)) {
+            searchBoggle(board, moves, words, result, processed, cell + move, path);
         }
     }
  
     // backtrack: mark the current node as unprocessed
-    processed[i][j] = false;
+    processed.reset(cell);
 }
  
-unordered_set<string> searchBoggle(auto const &board, auto const &words)
+unordered_set<string> searchBoggle(Grid<char> const &board, auto const &words)
 {
     // construct a set to store valid words constructed from the boggle
     unordered_set<string> result;
  
     // base case
-    if (board.size() == 0) {
+    if (board.rows() == 0) {
         return result;
     }
  
-    // `M × N` board
-    int M = board.size();
-    int N = board[0].size();
+    // the eight movements as constant offsets in the grid
+    auto moves = board.neighborOffsets(row, col);
  
-    // construct a boolean matrix to store whether a cell is processed or not
-     vector<vector<bool>> processed(M, vector<bool>(N));
+    // one bit per cell to store whether it is processed or not
+    DenseBitset processed(board.size());
  
     // generate all possible words in a boggle
-    for (int i = 0; i < M; i++)
+    for (int i = 0; i < board.rows(); i++)
     {
-        for (int j = 0; j < N; j++) {
+        for (int j = 0; j < board.cols(); j++) {
             // consider each character as a starting point and run DFS
-            searchBoggle(board, words, result, processed, i, j, "");
+            searchBoggle(board, moves, words, result, processed, board.index(i, j), "");
         }
     }
  
@@ -99,7 +104,8 @@ int main()
  
     unordered_set<string> words = { "START", "NOTE", "SAND", "STONED" };
  
-    unordered_set<string> output = searchBoggle(board, words);
+    // store the board in a flat grid with a ring of '\0' around it
+    unordered_set<string> output = searchBoggle(Grid<char>(board, '\0'), words);
     printSet(output);
  
     return 0;
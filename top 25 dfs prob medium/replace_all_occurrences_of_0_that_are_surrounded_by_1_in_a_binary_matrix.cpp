@@ -2,83 +2,76 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <array>
+#include "../common/bit_grid.h"
+#include "../common/grid.h"
+#include "../common/morphological_reconstruction.h"
 using namespace std;
  
 // Below arrays detail all eight possible movements
 int row[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
 int col[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
  
-// The function returns true if it is possible to go to cell `(x, y)`.
-// It returns false when the cell is invalid or is different from the target
-bool isSafe(vector<vector<int>> &mat, int x, int y, int target)
-{
-    int M = mat.size();
-    int N = mat[0].size();
- 
-    return (x >= 0 && x < M && y >= 0 && y < N) &&
-            mat[x][y] == target;
-}
+// The matrix is a `Grid` whose border ring holds 1, which is never the
+// value flooded, so the flood never leaves the matrix and the eight
+// movements need no bounds check.
  
 // Flood fill using DFS
-void floodfill(vector<vector<int>> &mat, int x, int y, int replacement)
+void floodfill(Grid<int> &mat, array<ptrdiff_t, 8> const &moves, size_t cell, int replacement)
 {
-    int M = mat.size();
-    int N = mat[0].size();
- 
     // get the target value
-    int target = mat[x][y];
+    int target = mat[cell];
  
     // replace current cell value with that of replacement
-    mat[x][y] = replacement;
+    mat[cell] = replacement;
  
     // process all eight adjacent cells of the current cell and
-    // recur for each valid cell
- 
-    for (int k = 0; k < 8; k++)
+    // recur for each one that has the same value as the current cell had
+    for (ptrdiff_t move: moves)
     {
-        // if the adjacent cell at position `(x + row[k], y + col[k])` is
-        // valid and has the same value as that of the current cell
- 
-        if (isSafe(mat, x + row[k], y + col[k], target)) {
-            floodfill(mat, x + row[k], y + col[k], replacement);
+        if (mat[cell + move] == target) {
+            floodfill(mat, moves, cell + move, replacement);
         }
     }
 }
  
 // Replace all occurrences of 0 by 1, which are surrounded
 // by 1 in a binary matrix
-void replaceZeroes(vector<vector<int>> &mat)
+void replaceZeroes(Grid<int> &mat)
 {
     // base case
-    if (mat.size() == 0) {
+    if (mat.rows() == 0) {
         return;
     }
  
     // `M × N` matrix
-    int M = mat.size();
-    int N = mat[0].size();
+    int M = mat.rows();
+    int N = mat.cols();
+ 
+    // the eight movements as constant offsets in the grid
+    auto moves = mat.neighborOffsets(row, col);
  
     // visit all cells in the first and last row of the matrix
     for (int i = 0; i < N; i++)
     {
-        if (mat[0][i] == 0) {
-            floodfill(mat, 0, i, -1);
+        if (mat(0, i) == 0) {
+            floodfill(mat, moves, mat.index(0, i), -1);
         }
  
-        if (mat[M - 1][i] == 0) {
-            floodfill(mat, M - 1, i, -1);
+        if (mat(M - 1, i) == 0) {
+            floodfill(mat, moves, mat.index(M - 1, i), -1);
         }
     }
  
     // visit all cells in the first and last column of the matrix
     for (int i = 0; i < M; i++)
     {
-        if (mat[i][0] == 0) {
-            floodfill(mat, i, 0, -1);
+        if (mat(i, 0) == 0) {
+            floodfill(mat, moves, mat.index(i, 0), -1);
         }
  
-        if (mat[i][N - 1] == 0) {
-            floodfill(mat, i, N - 1, -1);
+        if (mat(i, N - 1) == 0) {
+            floodfill(mat, moves, mat.index(i, N - 1), -1);
         }
     }
  
@@ -88,13 +81,49 @@ void replaceZeroes(vector<vector<int>> &mat)
         for (int j = 0; j < N; j++)
         {
             // replace every 0 with 1
-            if (mat[i][j] == 0) {
-                mat[i][j] = 1;
+            if (mat(i, j) == 0) {
+                mat(i, j) = 1;
             }
  
             // replace every -1 with 0
-            if (mat[i][j] == -1) {
-                mat[i][j] = 0;
+            if (mat(i, j) == -1) {
+                mat(i, j) = 0;
+            }
+        }
+    }
+}
+ 
+// Same result without recursion, for large matrices. The zeros connected to
+// the border are found at once by morphological reconstruction on a
+// bit-packed plane of the zeros: seeded with the border zeros and grown
+// through the zero plane with the eight movements, either 64 cells per word
+// operation (`orderedQueue` false) or one cell at a time from a queue, in
+// O(M × N) time whatever the shape of the zeros (`orderedQueue` true).
+void replaceZeroesByReconstruction(vector<vector<int>> &mat, bool orderedQueue)
+{
+    // base case
+    if (mat.size() == 0) {
+        return;
+    }
+ 
+    // `M × N` matrix
+    int M = mat.size();
+    int N = mat[0].size();
+ 
+    // one bit per zero of the matrix
+    BitGrid zeros(mat);
+    zeros.flip();
+ 
+    // the zeros connected to a zero on the border
+    BitGrid outside = borderConnected(zeros, EightConnected, orderedQueue);
+ 
+    // replace the zeros that are not connected to the border by 1
+    for (int i = 0; i < M; i++)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            if (zeros.test(i, j) && !outside.test(i, j)) {
+                mat[i][j] = 1;
             }
         }
     }
@@ -127,10 +156,24 @@ int main()
         { 1, 1, 1, 0, 1, 0, 1, 0, 0, 1 },
         { 1, 1, 1, 0, 1, 1, 1, 1, 1, 1 }
     };
+    vector<vector<int>> original = mat;
  
-    replaceZeroes(mat);
+    // flood from the border on a flat grid with a ring of 1 around it
+    Grid<int> grid(mat, 1);
+    replaceZeroes(grid);
+    mat = grid.toMatrix();
     printMatrix(mat);
  
+    // both reconstruction modes must give the same matrix
+    vector<vector<int>> dilation = original, queued = original;
+    replaceZeroesByReconstruction(dilation, false);
+    replaceZeroesByReconstruction(queued, true);
+ 
+    cout << "Word-parallel reconstruction gives the same matrix: "
+         << (dilation == mat ? "yes" : "no") << endl;
+    cout << "Ordered-queue reconstruction gives the same matrix: "
+         << (queued == mat ? "yes" : "no") << endl;
+ 
     return 0;
 }
 
@@ -148,5 +191,12 @@ int main()
 // [1, 1, 1, 0, 1, 1, 1, 1, 1, 1]
 // [1, 1, 1, 0, 1, 1, 1, 1, 1, 1]
 
+// Word-parallel reconstruction gives the same matrix: yes
+// Ordered-queue reconstruction gives the same matrix: yes
+
 // The time complexity of the proposed solution is O(M × N) for an M × N matrix. 
-// The auxiliary space required by the program is O(M × N) for recursion (call stack).
\ No newline at end of file
+// The auxiliary space required by the program is O(M × N) for recursion (call stack).
+// The ordered-queue reconstruction takes O(M × N) time, and the word-parallel
+// one O(M × N / 64) word operations per round; both use O(M × N) bits of
+// extra space and no recursion, and the queue also holds one 8-byte entry
+// per cell on the frontier of the fill in progress.
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <vector>
 #include <cstring>
 #include <iomanip>
+#include "../common/csr_graph.h"
+#include "../common/transitive_closure.h"
 using namespace std;
  
 // Data structure to store a graph edge
@@ -10,46 +12,14 @@ struct Edge {
 };
  
 // A class to represent a graph object
-class Graph
+class Graph: public CSRGraph<int>
 {
 public:
-    // a vector of vectors to represent an adjacency list
-    vector<vector<int>> adjList;
- 
     // Constructor
-    Graph(vector<Edge> const &edges, int n)
-    {
-        adjList.resize(n);
- 
-        // add edges to the directed graph
-        for (Edge edge: edges)
-        {
-            int src = edge.src;
-            int dest = edge.dest;
- 
-            adjList[src].push_back(dest);
-        }
-    }
+    // stores the directed graph in compressed sparse row form
+    Graph(vector<Edge> const &edges, int n): CSRGraph<int>(edges, n, Directed) {}
 };
  
-// `C` is a connectivity matrix and stores transitive closure of a graph
-// `root` is the topmost node in DFS tree (it is the starting vertex of DFS)
-// `descendant` is current vertex to be explored in DFS.
-// Invariant: A path already exists in the graph from `root` to `descendant`
-void DFS(Graph const &graph, vector<vector<bool>> &C, int root, int descendant)
-{
-    for (int child: graph.adjList[descendant])
-    {
-        // if `child` is an adjacent vertex of descendant, we have
-        // found a path from root->child
-        if (!C[root][child])
-        {
-            C[root][child] = true;
-            DFS(graph, C, root, child);
-        }
-    }
-}
- 
 int main()
 {
     // an array of graph edges as per the above diagram
@@ -63,20 +33,18 @@ int main()
     // build a graph from the given edges
     Graph graph(edges, n);
  
-    // `C` is a connectivity matrix and stores the transitive closure
-    // of the graph. The value of `C[i][j]` is 1 only if a directed
-    // path exists from vertex `i` to vertex `j`.
-    vector<vector<bool>> C(n, vector<bool>(n, false));
+    // `C` stores the transitive closure of the graph. `C.reachable(i, j)`
+    // is true only if a directed path exists from vertex `i` to vertex `j`.
+    // Vertices of the same strongly connected component share one row of
+    // the closure, and each row is computed once from the rows of the
+    // components it has arcs to.
+    TransitiveClosure C(graph);
  
-    // consider each vertex and start DFS from it
     for (int v = 0; v < n; v++)
     {
-        C[v][v] = true;
-        DFS(graph, C, v, v);
- 
         // print path info for vertex `v`
         for (int u = 0; u < n; u++) {
-            cout << left << setw(4) << C[v][u];
+            cout << left << setw(4) << C.reachable(v, u);
         }
         cout << endl;
     }
@@ -92,4 +60,8 @@ int main()
 // 0   0   1   0
 // 1   1   1   1
 
+// Computing the closure takes O(V + E) time for the components plus O(E × C / 64) word
+// operations for the rows, where C is the number of strongly connected components,
+// and O(C² / 8) bytes of memory.
+
 // Transitive closure is used to answer reachability queries (can we get to x from y?) efficiently in constant time after preprocessing of constructing the transitive closure.
\ No newline at end of file